@@ -8,9 +8,15 @@
 #define BOOST_HISTOGRAM_HPP_
 
 #include <boost/histogram/axis.hpp>
+#include <boost/histogram/fill_plan.hpp>
 #include <boost/histogram/histogram.hpp>
+#include <boost/histogram/histogram_bank.hpp>
 #include <boost/histogram/storage/adaptive_storage.hpp>
 #include <boost/histogram/storage/container_storage.hpp>
+#include <boost/histogram/storage/huge_page_allocator.hpp>
+#include <boost/histogram/storage/multi_weight_storage.hpp>
+#include <boost/histogram/storage/profile_storage.hpp>
+#include <boost/histogram/summed_area_table.hpp>
 #include <boost/histogram/utility.hpp>
 
 /**
@@ -14,7 +14,14 @@
 #include <boost/operators.hpp>
 #include <boost/utility/string_ref.hpp>
 #include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iterator>
 #include <limits>
+#include <memory>
+#include <ratio>
 #include <stdexcept>
 #include <string>
 #include <type_traits>
@@ -23,6 +30,77 @@
 namespace boost {
 namespace histogram {
 
+namespace detail {
+// largest number of bins an axis may grow by in one step
+constexpr int max_growth = std::numeric_limits<int>::max() / 4;
+
+// growing by at least a quarter of the bins amortizes storage relocations
+inline int growth_bins(int needed, int bins) {
+  return std::max(needed, (bins + 3) / 4);
+}
+
+// FNV-1a, short keys like names and status strings hash in a few cycles
+inline std::size_t hash_string(string_ref s) {
+  std::uint64_t h = 14695981039346656037ull;
+  for (const char c : s) {
+    h = (h ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+  }
+  return static_cast<std::size_t>(h ^ (h >> 32));
+}
+
+/** Natural logarithm with an absolute error below 1e-9.
+ *
+ * Splits x into exponent and mantissa with bit operations and evaluates a
+ * short series, so that loops over it vectorize. Values which are not
+ * positive normal numbers fall back to std::log.
+ */
+inline double fast_log(double x) {
+  if (!(x >= std::numeric_limits<double>::min() &&
+        x <= std::numeric_limits<double>::max())) {
+    return std::log(x);
+  }
+  std::uint64_t b;
+  std::memcpy(&b, &x, sizeof(b));
+  int e = static_cast<int>(b >> 52) - 1023;
+  b = (b & 0x000fffffffffffffull) | 0x3ff0000000000000ull;
+  double m;
+  std::memcpy(&m, &b, sizeof(m));
+  // move m into [sqrt(1/2), sqrt(2)), so that the series converges fast
+  const bool high = m > 1.4142135623730951;
+  m *= high ? 0.5 : 1.0;
+  e += high;
+  // log(m) = 2 artanh(t), where |t| < 0.18
+  const double t = (m - 1) / (m + 1), t2 = t * t;
+  const double s =
+      t * (2 + t2 * (2. / 3 + t2 * (2. / 5 + t2 * (2. / 7 + t2 * (2. / 9)))));
+  return e * 0.6931471805599453 + s;
+}
+
+/// Position of the most significant bit of x > 0
+inline int msb(std::uint64_t x) {
+#if defined(__GNUC__)
+  return 63 - __builtin_clzll(x);
+#else
+  int r = 0;
+  while (x >>= 1) {
+    ++r;
+  }
+  return r;
+#endif
+}
+
+// calls t.approx(x) if the transform has it, else t.forward(x)
+template <typename T, typename X>
+inline auto transform_approx(const T &t, X x, int) -> decltype(t.approx(x)) {
+  return t.approx(x);
+}
+
+template <typename T, typename X>
+inline X transform_approx(const T &t, X x, long) {
+  return t.forward(x);
+}
+} // namespace detail
+
 template <typename Value> struct bin {
   int idx;
   Value value;
@@ -42,12 +120,16 @@ template <typename Value>
 using axis_bin = typename std::conditional<std::is_floating_point<Value>::value,
                                            real_bin<Value>, bin<Value>>::type;
 
+// type of the bin edges, which may be wider than the value_type
+template <typename Axis>
+using axis_edge = decltype(std::declval<const Axis &>()[0]);
+
 template <typename Axis>
 class axis_iterator
     : public iterator_facade<axis_iterator<Axis>,
-                             const axis_bin<typename Axis::value_type>,
+                             const axis_bin<axis_edge<Axis>>,
                              random_access_traversal_tag> {
-  using bin_type = axis_bin<typename Axis::value_type>;
+  using bin_type = axis_bin<axis_edge<Axis>>;
 
 public:
   explicit axis_iterator(const Axis &axis, int idx) : axis_(axis), value_() {
@@ -129,6 +211,12 @@ protected:
     return size_ == o.size_ && shape_ == o.shape_ && label_ == o.label_;
   }
 
+  /// Changes the number of bins, keeping under-/overflow bins if present.
+  void resize(int n) {
+    shape_ += n - size_;
+    size_ = n;
+  }
+
 private:
   int size_ = 0;
   int shape_ = 0;
@@ -152,9 +240,9 @@ public:
   void label(const std::string &label) { label_ = label; }
 
 protected:
-  axis_base(unsigned n, std::string label)
+  axis_base(unsigned n, std::string label, bool allow_empty = false)
       : size_(n), label_(std::move(label)) {
-    if (n == 0) {
+    if (n == 0 && !allow_empty) {
       throw std::logic_error("bins > 0 required");
     }
   }
@@ -179,6 +267,9 @@ protected:
     return size_ == other.size_ && label_ == other.label_;
   }
 
+  /// Changes the number of bins.
+  void resize(int n) { size_ = n; }
+
 private:
   int size_ = 0;
   std::string label_;
@@ -206,13 +297,20 @@ public:
    * \param max high edge of last bin.
    * \param label description of the axis.
    * \param uoflow whether to add under-/overflow bins.
+   * \param growth whether to extend the range for values outside of it,
+   *        requires uoflow == false.
    */
   regular_axis(unsigned n, value_type min, value_type max,
-               const std::string &label = std::string(), bool uoflow = true)
-      : axis_base<true>(n, label, uoflow), min_(min), delta_((max - min) / n) {
+               const std::string &label = std::string(), bool uoflow = true,
+               bool growth = false)
+      : axis_base<true>(n, label, uoflow), min_(min), delta_((max - min) / n),
+        anchor_(min), growth_(growth) {
     if (!(min < max)) {
       throw std::logic_error("min < max required");
     }
+    if (growth && uoflow) {
+      throw std::logic_error("growth requires uoflow == false");
+    }
   }
 
   regular_axis() = default;
@@ -228,6 +326,61 @@ public:
     return z >= 0.0 ? (z > bins() ? bins() : static_cast<int>(z)) : -1;
   }
 
+  /** Writes the bin indices of the values [begin, end) to out.
+   *
+   * A block of values is binned in a separate loop without branches, which
+   * the compiler can vectorize. Input of type float to an axis of double is
+   * processed in single precision, so that twice as many values fit into a
+   * vector register. Values that are so close to a bin edge that the
+   * rounding may matter are binned again with index(x), so the result is
+   * always that of index(x).
+   */
+  template <typename Iterator, typename OutputIterator>
+  void index(Iterator begin, Iterator end, OutputIterator out) const {
+    using input_type = typename std::iterator_traits<Iterator>::value_type;
+    using K = typename std::conditional<std::is_same<input_type, float>::value,
+                                        float, value_type>::type;
+    constexpr unsigned block = 64;
+    const K min = static_cast<K>(min_), inv = static_cast<K>(1 / delta_);
+    const K n = static_cast<K>(bins());
+    // bound of the relative error of z from rounding of min, inv and z
+    const K eps = 8 * std::numeric_limits<K>::epsilon();
+    const auto bin = [n](K z) {
+      const K zc = z >= 0 ? z : K(-1);
+      return static_cast<int>(zc > n ? n : zc);
+    };
+    input_type x[block];
+    int j[block], near[block];
+    while (begin != end) {
+      unsigned m = 0;
+      for (; m < block && begin != end; ++m, ++begin) {
+        x[m] = *begin;
+      }
+      if (std::is_same<K, value_type>::value) {
+        // the operations of index(x), so no value needs a second look
+        for (unsigned i = 0; i < m; ++i) {
+          j[i] = bin((static_cast<value_type>(x[i]) - min_) / delta_);
+        }
+        for (unsigned i = 0; i < m; ++i) {
+          *out++ = j[i];
+        }
+        continue;
+      }
+      for (unsigned i = 0; i < m; ++i) {
+        const K xi = static_cast<K>(x[i]);
+        const K z = (xi - min) * inv;
+        const K tol =
+            eps * (1 + std::abs(z) + (std::abs(xi) + std::abs(min)) * inv);
+        j[i] = bin(z);
+        // the exact z lies in [z - tol, z + tol]
+        near[i] = bin(z - tol) != bin(z + tol);
+      }
+      for (unsigned i = 0; i < m; ++i) {
+        *out++ = near[i] ? index(static_cast<value_type>(x[i])) : j[i];
+      }
+    }
+  }
+
   /// Returns the starting edge of the bin.
   value_type operator[](int idx) const {
     if (idx < 0) {
@@ -236,13 +389,40 @@ public:
     if (idx > bins()) {
       return std::numeric_limits<value_type>::infinity();
     }
-    const value_type z = value_type(idx) / bins();
-    return (1.0 - z) * min_ + z * (min_ + delta_ * bins());
+    // edges lie on the grid of the constructor, however the axis grew
+    return anchor_ + (idx - offset_) * delta_;
   }
 
   bool operator==(const regular_axis &o) const {
     return axis_base<true>::operator==(o) && min_ == o.min_ &&
-           delta_ == o.delta_;
+           delta_ == o.delta_ && growth_ == o.growth_;
+  }
+
+  /// Returns whether the axis grows to include values outside of its range.
+  bool growth() const { return growth_; }
+
+  /** Extends the axis by whole bins so that x falls inside.
+   *
+   * Returns the number of bins added below the previous range. Does nothing
+   * if growth is disabled, x is inside or x is not finite. The new lower
+   * edge is computed from the lower edge given to the constructor and the
+   * number of bins below it, so that rounding does not accumulate.
+   */
+  int grow(value_type x) {
+    const value_type z = std::floor((x - min_) / delta_);
+    const int n = bins();
+    if (!growth_ || !(z < 0 || z >= n) || !(std::abs(z) < detail::max_growth)) {
+      return 0;
+    }
+    if (z < 0) {
+      const int k = detail::growth_bins(static_cast<int>(-z), n);
+      offset_ += k;
+      min_ = anchor_ - offset_ * delta_;
+      resize(n + k);
+      return k;
+    }
+    resize(n + detail::growth_bins(static_cast<int>(z) - n + 1, n));
+    return 0;
   }
 
   const_iterator begin() const {
@@ -255,11 +435,268 @@ public:
 
 private:
   value_type min_ = 0.0, delta_ = 1.0;
+  // min_ is anchor_ - offset_ * delta_, offset_ counts the bins grown below
+  value_type anchor_ = 0.0;
+  int offset_ = 0;
+  bool growth_ = false;
 
   template <class Archive, typename RealType1>
   friend void serialize(Archive &, regular_axis<RealType1> &, unsigned);
 };
 
+/** Axis with bins of equal width and bounds fixed at compile time.
+ *
+ * The bounds are given as std::ratio, for example
+ * static_regular_axis<10, std::ratio<-1>, std::ratio<1>> for 10 bins in
+ * [-1, 1). bins() and shape() are compile-time constants and index() is a
+ * subtraction and a multiplication with constants.
+ */
+template <unsigned N, typename Min, typename Max, bool UOFlow = true,
+          typename RealType = double>
+class static_regular_axis
+    : boost::operators<static_regular_axis<N, Min, Max, UOFlow, RealType>> {
+  static_assert(N > 0, "bins > 0 required");
+  static_assert(std::ratio_less<Min, Max>::value, "min < max required");
+
+public:
+  using value_type = RealType;
+  using const_iterator = axis_iterator<static_regular_axis>;
+
+  explicit static_regular_axis(const std::string &label = std::string())
+      : label_(label) {}
+
+  /// Returns the number of bins, excluding overflow/underflow.
+  static constexpr int bins() { return N; }
+  /// Returns the number of bins, including overflow/underflow.
+  static constexpr int shape() { return N + 2 * UOFlow; }
+  /// Returns whether axis has extra overflow and underflow bins.
+  static constexpr bool uoflow() { return UOFlow; }
+  /// Returns the axis label, which is a name or description.
+  const std::string &label() const { return label_; }
+  /// Change the label of an axis.
+  void label(const std::string &label) { label_ = label; }
+
+  /// Returns the bin index for the passed argument.
+  inline int index(value_type x) const noexcept {
+    const value_type z = (x - min()) * scale();
+    return z >= 0.0 ? (z > N ? N : static_cast<int>(z)) : -1;
+  }
+
+  /// Returns the starting edge of the bin.
+  value_type operator[](int idx) const {
+    if (idx < 0) {
+      return -std::numeric_limits<value_type>::infinity();
+    }
+    if (idx > bins()) {
+      return std::numeric_limits<value_type>::infinity();
+    }
+    const value_type z = value_type(idx) / bins();
+    return (1.0 - z) * min() + z * max();
+  }
+
+  bool operator==(const static_regular_axis &o) const {
+    return label_ == o.label_;
+  }
+
+  const_iterator begin() const {
+    return const_iterator(*this, uoflow() ? -1 : 0);
+  }
+
+  const_iterator end() const {
+    return const_iterator(*this, uoflow() ? bins() + 1 : bins());
+  }
+
+  static constexpr value_type min() {
+    return value_type(Min::num) / value_type(Min::den);
+  }
+
+  static constexpr value_type max() {
+    return value_type(Max::num) / value_type(Max::den);
+  }
+
+private:
+  using width = std::ratio_subtract<Max, Min>;
+
+  // bins per unit of x
+  static constexpr value_type scale() {
+    return value_type(N) * value_type(width::den) / value_type(width::num);
+  }
+
+  std::string label_;
+
+  template <class Archive, unsigned N1, typename Min1, typename Max1, bool U1,
+            typename RealType1>
+  friend void serialize(Archive &,
+                        static_regular_axis<N1, Min1, Max1, U1, RealType1> &,
+                        unsigned);
+};
+
+/// Monotonically increasing transforms for transform_axis.
+namespace transform {
+
+struct log {
+  template <typename T> T forward(T x) const { return std::log(x); }
+  template <typename T> T inverse(T x) const { return std::exp(x); }
+  template <typename T> T approx(T x) const {
+    return static_cast<T>(detail::fast_log(x));
+  }
+  bool operator==(const log &) const { return true; }
+};
+
+struct sqrt {
+  template <typename T> T forward(T x) const { return std::sqrt(x); }
+  template <typename T> T inverse(T x) const { return x * x; }
+  bool operator==(const sqrt &) const { return true; }
+};
+
+/// x^power for x >= 0 and power > 0
+struct pow {
+  double power = 1.0;
+  pow() = default;
+  explicit pow(double p) : power(p) {}
+  template <typename T> T forward(T x) const { return std::pow(x, power); }
+  template <typename T> T inverse(T x) const {
+    return std::pow(x, 1.0 / power);
+  }
+  bool operator==(const pow &o) const { return power == o.power; }
+};
+
+} // namespace transform
+
+/** Axis with bins of equal width in the space of a transform.
+ *
+ * For example, transform::log gives bins of equal width in log(x). The
+ * Transform has const members forward(x) and inverse(y), which must be
+ * monotonically increasing, and optionally approx(x), a fast approximation
+ * of forward(x), and an operator==. Binning is a O(1) operation. A bin
+ * found with the approximation is corrected against the exact edges, so
+ * that the result matches the exact transform.
+ */
+template <typename Transform, typename RealType = double>
+class transform_axis : public axis_base<true>,
+                       boost::operators<transform_axis<Transform, RealType>> {
+public:
+  using value_type = RealType;
+  using transform_type = Transform;
+  using const_iterator = axis_iterator<transform_axis>;
+
+  /** Construct axis with n bins over range [min, max).
+   *
+   * \param n number of bins.
+   * \param min low edge of first bin.
+   * \param max high edge of last bin.
+   * \param label description of the axis.
+   * \param uoflow whether to add under-/overflow bins.
+   * \param t the transform.
+   */
+  transform_axis(unsigned n, value_type min, value_type max,
+                 const std::string &label = std::string(), bool uoflow = true,
+                 const Transform &t = Transform())
+      : axis_base<true>(n, label, uoflow), transform_(t),
+        min_(t.forward(min)), delta_((t.forward(max) - min_) / n) {
+    if (!(min < max) || !(delta_ > 0) || !std::isfinite(min_) ||
+        !std::isfinite(delta_)) {
+      throw std::logic_error("min < max and finite transformed range required");
+    }
+    build_edges(min, max);
+  }
+
+  transform_axis() = default;
+  transform_axis(const transform_axis &) = default;
+  transform_axis &operator=(const transform_axis &) = default;
+  transform_axis(transform_axis &&) = default;
+  transform_axis &operator=(transform_axis &&) = default;
+
+  /// Returns the bin index for the passed argument.
+  inline int index(value_type x) const noexcept {
+    return correct(x, guess(detail::transform_approx(transform_, x, 0)));
+  }
+
+  /** Writes the bin indices of the values [begin, end) to out.
+   *
+   * The approximate transform of a block of values is computed in a
+   * separate loop, which the compiler can vectorize.
+   */
+  template <typename Iterator, typename OutputIterator>
+  void index(Iterator begin, Iterator end, OutputIterator out) const {
+    constexpr unsigned block = 64;
+    value_type x[block], y[block];
+    while (begin != end) {
+      unsigned n = 0;
+      for (; n < block && begin != end; ++n, ++begin) {
+        x[n] = *begin;
+      }
+      for (unsigned i = 0; i < n; ++i) {
+        y[i] = detail::transform_approx(transform_, x[i], 0);
+      }
+      for (unsigned i = 0; i < n; ++i) {
+        *out++ = correct(x[i], guess(y[i]));
+      }
+    }
+  }
+
+  /// Returns the starting edge of the bin.
+  value_type operator[](int idx) const {
+    if (idx < 0) {
+      return -std::numeric_limits<value_type>::infinity();
+    }
+    if (idx > bins()) {
+      return std::numeric_limits<value_type>::infinity();
+    }
+    return edges_[idx];
+  }
+
+  /// Returns the transform.
+  const Transform &transform() const { return transform_; }
+
+  bool operator==(const transform_axis &o) const {
+    return axis_base<true>::operator==(o) && transform_ == o.transform_ &&
+           min_ == o.min_ && delta_ == o.delta_;
+  }
+
+  const_iterator begin() const {
+    return const_iterator(*this, uoflow() ? -1 : 0);
+  }
+
+  const_iterator end() const {
+    return const_iterator(*this, uoflow() ? bins() + 1 : bins());
+  }
+
+private:
+  Transform transform_;
+  value_type min_ = 0.0, delta_ = 1.0;
+  // exact bin edges in the original space
+  std::vector<value_type> edges_;
+
+  void build_edges(value_type min, value_type max) {
+    edges_.resize(bins() + 1);
+    edges_.front() = min;
+    for (int i = 1; i < bins(); ++i) {
+      edges_[i] = transform_.inverse(min_ + i * delta_);
+    }
+    edges_.back() = max;
+  }
+
+  // bin from the approximate transform, NaN goes to the underflow bin
+  inline int guess(value_type y) const noexcept {
+    const value_type z = (y - min_) / delta_;
+    return z >= 0.0 ? (z > bins() ? bins() : static_cast<int>(z)) : -1;
+  }
+
+  inline int correct(value_type x, int j) const noexcept {
+    while (j >= 0 && x < edges_[j]) {
+      --j;
+    }
+    while (j < bins() && x >= edges_[j + 1]) {
+      ++j;
+    }
+    return j;
+  }
+
+  template <class Archive, typename T, typename RealType1>
+  friend void serialize(Archive &, transform_axis<T, RealType1> &, unsigned);
+};
+
 /** Axis for real-valued angles.
  *
  * The axis is circular and wraps around reaching the
@@ -293,9 +730,42 @@ public:
 
   /// Returns the bin index for the passed argument.
   inline int index(value_type x) const noexcept {
-    const value_type z = (x - phase_) / perimeter_;
-    const int i = static_cast<int>(std::floor(z * bins())) % bins();
-    return i + (i < 0) * bins();
+    const value_type y = (x - phase_) / perimeter_ * bins();
+    return std::abs(y) < bins() ? wrap(y) : exact(x);
+  }
+
+  /** Writes the bin indices of the values [begin, end) to out.
+   *
+   * The indices of a block of values are computed in a separate loop
+   * without branches, which the compiler can vectorize.
+   */
+  template <typename Iterator, typename OutputIterator>
+  void index(Iterator begin, Iterator end, OutputIterator out) const {
+    constexpr unsigned block = 64;
+    value_type x[block], y[block];
+    bool ok[block];
+    int j[block];
+    while (begin != end) {
+      unsigned n = 0;
+      for (; n < block && begin != end; ++n, ++begin) {
+        x[n] = *begin;
+      }
+      for (unsigned i = 0; i < n; ++i) {
+        y[i] = (x[i] - phase_) / perimeter_ * bins();
+      }
+      for (unsigned i = 0; i < n; ++i) {
+        ok[i] = std::abs(y[i]) < bins();
+        if (!ok[i]) {
+          y[i] = 0;
+        }
+      }
+      for (unsigned i = 0; i < n; ++i) {
+        j[i] = wrap(y[i]);
+      }
+      for (unsigned i = 0; i < n; ++i) {
+        *out++ = ok[i] ? j[i] : exact(x[i]);
+      }
+    }
   }
 
   /// Returns the starting edge of the bin.
@@ -319,6 +789,23 @@ public:
 private:
   value_type phase_ = 0.0, perimeter_ = 1.0;
 
+  /* Returns floor(y) modulo bins for |y| < bins, that is for values within
+   * one period around the phase. The floor is a truncation with a
+   * correction for negative values, the modulo a masked add.
+   */
+  inline int wrap(value_type y) const noexcept {
+    const int t = static_cast<int>(y);
+    const int k = t - (y < t);
+    return k + (-(k < 0) & bins());
+  }
+
+  // reference computation for values further away and not finite ones
+  inline int exact(value_type x) const noexcept {
+    const value_type z = (x - phase_) / perimeter_;
+    const int i = static_cast<int>(std::floor(z * bins())) % bins();
+    return i + (i < 0) * bins();
+  }
+
   template <class Archive, typename RealType1>
   friend void serialize(Archive &, circular_axis<RealType1> &, unsigned);
 };
@@ -382,6 +869,53 @@ public:
     return std::upper_bound(x_.get(), x_.get() + bins() + 1, x) - x_.get() - 1;
   }
 
+  /** Returns the bin index for the passed argument, searching from hint.
+   *
+   * The search gallops away from the bin in hint with steps of 1, 2, 4, ...
+   * before it bisects, so it is O(1) if x is in the bin of the previous
+   * call or close to it. The result is stored in hint for the next call.
+   * Any int is a valid hint; the result equals index(x).
+   */
+  int index(value_type x, int &hint) const noexcept {
+    const value_type *e = x_.get();
+    const int n = bins() + 1;
+    // u is the position of the first edge greater than x
+    const int u = std::min(std::max(hint + 1, 0), n);
+    int lo, hi;
+    if (u == n || x < e[u]) {
+      hi = u;
+      int p = u - 1;
+      for (int step = 1; p >= 0 && x < e[p]; step *= 2) {
+        hi = p;
+        p -= step;
+      }
+      lo = p < 0 ? 0 : p + 1;
+    } else {
+      lo = u + 1;
+      int p = lo;
+      for (int step = 1; p < n && !(x < e[p]); step *= 2) {
+        lo = p + 1;
+        p += step;
+      }
+      hi = std::min(p, n);
+    }
+    hint = std::upper_bound(e + lo, e + hi, x) - e - 1;
+    return hint;
+  }
+
+  /** Writes the bin indices of the values [begin, end) to out.
+   *
+   * Each search starts from the bin of the previous value, so sorted or
+   * slowly varying input is binned in O(1) per value.
+   */
+  template <typename Iterator, typename OutputIterator>
+  void index(Iterator begin, Iterator end, OutputIterator out) const {
+    int hint = 0;
+    for (; begin != end; ++begin) {
+      *out++ = index(*begin, hint);
+    }
+  }
+
   /// Returns the starting edge of the bin.
   value_type operator[](int idx) const {
     if (idx < 0) {
@@ -415,6 +949,160 @@ private:
   friend void serialize(Archive &, variable_axis<RealType1> &, unsigned);
 };
 
+/** An axis for small unsigned integers, binned with a lookup table.
+ *
+ * The axis is defined by integer bin edges like a variable_axis, from
+ * which a table of the bin index of every representable input value is
+ * built, so that binning is a single load. Meant for 8 and 16 bit inputs,
+ * for which the table has at most 2^16 entries.
+ */
+template <typename UInt = std::uint16_t>
+class lookup_axis : public axis_base<true>,
+                    boost::operators<lookup_axis<UInt>> {
+  static_assert(std::is_unsigned<UInt>::value &&
+                    std::numeric_limits<UInt>::digits <= 16,
+                "UInt must be an unsigned integer with at most 16 bits");
+
+public:
+  using value_type = UInt;
+  using const_iterator = axis_iterator<lookup_axis>;
+
+  /// Number of representable input values
+  static constexpr int domain = 1 << std::numeric_limits<UInt>::digits;
+
+  /** Construct an axis from integer bin edges.
+   *
+   * \param x increasing sequence of bin edges in [0, 2^digits of UInt].
+   * \param label description of the axis.
+   * \param uoflow whether to add under-/overflow bins.
+   */
+  lookup_axis(const std::initializer_list<int> &x,
+              const std::string &label = std::string(), bool uoflow = true)
+      : lookup_axis(x.begin(), x.end(), label, uoflow) {}
+
+  template <typename Iterator>
+  lookup_axis(Iterator begin, Iterator end,
+              const std::string &label = std::string(), bool uoflow = true)
+      : axis_base<true>(std::max<int>(std::distance(begin, end), 2) - 1,
+                        label, uoflow),
+        x_(begin, end) {
+    if (x_.size() < 2) {
+      throw std::logic_error("at least two values required");
+    }
+    if (x_.front() < 0 || x_.back() > domain ||
+        std::adjacent_find(x_.begin(), x_.end(), std::greater_equal<int>()) !=
+            x_.end()) {
+      throw std::logic_error("edges must increase and lie inside the domain "
+                             "of the input type");
+    }
+    build_table();
+  }
+
+  lookup_axis() = default;
+  lookup_axis(const lookup_axis &) = default;
+  lookup_axis &operator=(const lookup_axis &) = default;
+  lookup_axis(lookup_axis &&) = default;
+  lookup_axis &operator=(lookup_axis &&) = default;
+
+  /// Returns the bin index for the passed argument.
+  inline int index(value_type x) const noexcept { return table_[x]; }
+
+  /// Returns the bin index for an argument of another type, which is -1
+  /// below zero and bins() from the size of the input domain on or for NaN.
+  template <typename T, typename = typename std::enable_if<
+                            std::is_arithmetic<T>::value &&
+                            !std::is_same<T, value_type>::value>::type>
+  inline int index(T x) const noexcept {
+    const double d = x;
+    return d < 0 ? -1 : d < domain ? table_[static_cast<int>(d)] : bins();
+  }
+
+  /** Writes the bin indices of the values [begin, end) to out.
+   *
+   * The table loads of a block of values are issued in a separate loop,
+   * which the compiler can turn into gather instructions. Values of other
+   * types than value_type are range-checked one by one, see index(T).
+   */
+  template <typename Iterator, typename OutputIterator>
+  void index(Iterator begin, Iterator end, OutputIterator out) const {
+    using T = typename std::iterator_traits<Iterator>::value_type;
+    index_impl(begin, end, out, std::is_same<T, value_type>());
+  }
+
+  /// Returns the starting edge of the bin, the underflow bin starts at 0
+  /// and the end of the overflow bin is the size of the input domain.
+  int operator[](int idx) const {
+    if (idx < 0) {
+      return 0;
+    }
+    if (idx > bins()) {
+      return domain;
+    }
+    return x_[idx];
+  }
+
+  bool operator==(const lookup_axis &o) const {
+    return axis_base<true>::operator==(o) && x_ == o.x_;
+  }
+
+  const_iterator begin() const {
+    return const_iterator(*this, uoflow() ? -1 : 0);
+  }
+
+  const_iterator end() const {
+    return const_iterator(*this, uoflow() ? bins() + 1 : bins());
+  }
+
+private:
+  std::vector<int> x_;
+  std::vector<int> table_;
+
+  void build_table() {
+    table_.resize(domain);
+    int j = -1;
+    for (int v = 0; v < domain; ++v) {
+      while (j < bins() && v >= x_[j + 1]) {
+        ++j;
+      }
+      table_[v] = j;
+    }
+  }
+
+  template <typename Iterator, typename OutputIterator>
+  void index_impl(Iterator begin, Iterator end, OutputIterator out,
+                  std::true_type) const {
+    constexpr unsigned block = 64;
+    value_type x[block];
+    int j[block];
+    const int *t = table_.data();
+    while (begin != end) {
+      unsigned n = 0;
+      for (; n < block && begin != end; ++n, ++begin) {
+        x[n] = *begin;
+      }
+      for (unsigned i = 0; i < n; ++i) {
+        j[i] = t[x[i]];
+      }
+      for (unsigned i = 0; i < n; ++i) {
+        *out++ = j[i];
+      }
+    }
+  }
+
+  template <typename Iterator, typename OutputIterator>
+  void index_impl(Iterator begin, Iterator end, OutputIterator out,
+                  std::false_type) const {
+    for (; begin != end; ++begin) {
+      *out++ = index(*begin);
+    }
+  }
+
+  template <class Archive, typename UInt1>
+  friend void serialize(Archive &, lookup_axis<UInt1> &, unsigned);
+};
+
+template <typename UInt> constexpr int lookup_axis<UInt>::domain;
+
 /** An axis for a contiguous range of integers.
  *
  * Binning is a O(1) operation. This axis operates
@@ -429,13 +1117,20 @@ public:
    *
    * \param min smallest integer of the covered range.
    * \param max largest integer of the covered range.
+   * \param growth whether to extend the range for values outside of it,
+   *        requires uoflow == false.
    */
   integer_axis(value_type min, value_type max,
-               const std::string &label = std::string(), bool uoflow = true)
-      : axis_base<true>(max + 1 - min, label, uoflow), min_(min) {
+               const std::string &label = std::string(), bool uoflow = true,
+               bool growth = false)
+      : axis_base<true>(max + 1 - min, label, uoflow), min_(min),
+        growth_(growth) {
     if (min > max) {
       throw std::logic_error("min <= max required");
     }
+    if (growth && uoflow) {
+      throw std::logic_error("growth requires uoflow == false");
+    }
   }
 
   integer_axis() = default;
@@ -454,7 +1149,32 @@ public:
   value_type operator[](int idx) const { return min_ + idx; }
 
   bool operator==(const integer_axis &o) const {
-    return axis_base<true>::operator==(o) && min_ == o.min_;
+    return axis_base<true>::operator==(o) && min_ == o.min_ &&
+           growth_ == o.growth_;
+  }
+
+  /// Returns whether the axis grows to include values outside of its range.
+  bool growth() const { return growth_; }
+
+  /** Extends the axis by whole bins so that x falls inside.
+   *
+   * Returns the number of bins added below the previous range. Does nothing
+   * if growth is disabled or x is inside.
+   */
+  int grow(value_type x) {
+    const long z = static_cast<long>(x) - min_;
+    const int n = bins();
+    if (!growth_ || !(z < 0 || z >= n) || !(std::labs(z) < detail::max_growth)) {
+      return 0;
+    }
+    if (z < 0) {
+      const int k = detail::growth_bins(static_cast<int>(-z), n);
+      min_ -= k;
+      resize(n + k);
+      return k;
+    }
+    resize(n + detail::growth_bins(static_cast<int>(z) - n + 1, n));
+    return 0;
   }
 
   const_iterator begin() const {
@@ -467,17 +1187,218 @@ public:
 
 private:
   value_type min_ = 0;
+  bool growth_ = false;
 
   template <class Archive>
   friend void serialize(Archive &, integer_axis &, unsigned);
 };
 
+/** An axis for integers in bins whose width is a power of two.
+ *
+ * The bin is found with a subtraction, a shift and an unsigned compare,
+ * without a conversion to floating point.
+ */
+class shift_axis : public axis_base<true>, boost::operators<shift_axis> {
+public:
+  using value_type = int;
+  using const_iterator = axis_iterator<shift_axis>;
+
+  /** Construct n bins of width 2^shift, starting at min.
+   *
+   * \param n number of bins.
+   * \param min smallest integer of the covered range.
+   * \param shift binary logarithm of the bin width.
+   * \param label description of the axis.
+   * \param uoflow whether to add under-/overflow bins.
+   */
+  shift_axis(unsigned n, value_type min, unsigned shift,
+             const std::string &label = std::string(), bool uoflow = true)
+      : axis_base<true>(n, label, uoflow), min_(min), shift_(shift) {
+    if (shift > 30 || (static_cast<std::uint64_t>(n) << shift) >> 31 ||
+        static_cast<std::int64_t>(min) + (static_cast<std::int64_t>(n) << shift) >
+            std::numeric_limits<value_type>::max() + std::int64_t(1)) {
+      throw std::logic_error("range of shift_axis must fit into int");
+    }
+  }
+
+  shift_axis() = default;
+  shift_axis(const shift_axis &) = default;
+  shift_axis &operator=(const shift_axis &) = default;
+  shift_axis(shift_axis &&) = default;
+  shift_axis &operator=(shift_axis &&) = default;
+
+  /// Returns the bin index for the passed argument.
+  inline int index(value_type x) const noexcept {
+    // values below min wrap around to large unsigned numbers
+    const unsigned z =
+        static_cast<unsigned>(x) - static_cast<unsigned>(min_);
+    if (z < range()) {
+      return z >> shift_;
+    }
+    return x < min_ ? -1 : bins();
+  }
+
+  /** Writes the bin indices of the values [begin, end) to out.
+   *
+   * The indices of a block of values are computed in a separate loop
+   * without branches, which the compiler can vectorize.
+   */
+  template <typename Iterator, typename OutputIterator>
+  void index(Iterator begin, Iterator end, OutputIterator out) const {
+    constexpr unsigned block = 64;
+    value_type x[block];
+    int j[block];
+    const unsigned min = min_, r = range();
+    const int n = bins();
+    while (begin != end) {
+      unsigned m = 0;
+      for (; m < block && begin != end; ++m, ++begin) {
+        x[m] = *begin;
+      }
+      for (unsigned i = 0; i < m; ++i) {
+        const unsigned z = static_cast<unsigned>(x[i]) - min;
+        const int k = x[i] < min_ ? -1 : n;
+        j[i] = z < r ? static_cast<int>(z >> shift_) : k;
+      }
+      for (unsigned i = 0; i < m; ++i) {
+        *out++ = j[i];
+      }
+    }
+  }
+
+  /// Returns the starting edge of the bin.
+  value_type operator[](int idx) const { return min_ + idx * width(); }
+
+  /// Returns the binary logarithm of the bin width.
+  unsigned shift() const { return shift_; }
+  /// Returns the bin width.
+  value_type width() const { return 1 << shift_; }
+
+  bool operator==(const shift_axis &o) const {
+    return axis_base<true>::operator==(o) && min_ == o.min_ &&
+           shift_ == o.shift_;
+  }
+
+  const_iterator begin() const {
+    return const_iterator(*this, uoflow() ? -1 : 0);
+  }
+
+  const_iterator end() const {
+    return const_iterator(*this, uoflow() ? bins() + 1 : bins());
+  }
+
+private:
+  value_type min_ = 0;
+  unsigned shift_ = 0;
+
+  unsigned range() const { return static_cast<unsigned>(bins()) << shift_; }
+
+  template <class Archive>
+  friend void serialize(Archive &, shift_axis &, unsigned);
+};
+
+/** An axis for non-negative integers with a fixed relative precision.
+ *
+ * Values below 2^p, where p is the number of significant bits, have one bin
+ * each. Above, every power-of-two range [2^e, 2^(e+1)) is split into 2^(p-1)
+ * bins of equal width, so the relative bin width is at most 2^(1-p), as in
+ * HdrHistogram. The bin is found with a count-leading-zeros and a shift.
+ * Values above max go into the overflow bin; there is no underflow.
+ */
+class log_linear_axis : public axis_base<true>,
+                        boost::operators<log_linear_axis> {
+public:
+  using value_type = std::uint64_t;
+  using const_iterator = axis_iterator<log_linear_axis>;
+
+  /** Construct axis over integer range [0, max].
+   *
+   * \param significant_bits number of significant bits p, from 1 to 24.
+   * \param max largest value of the covered range, below 2^63.
+   * \param label description of the axis.
+   * \param uoflow whether to add under-/overflow bins.
+   */
+  log_linear_axis(unsigned significant_bits, value_type max,
+                  const std::string &label = std::string(), bool uoflow = true)
+      : axis_base<true>(check(significant_bits, max) + 1, label, uoflow),
+        p_(significant_bits), max_(max) {}
+
+  log_linear_axis() = default;
+  log_linear_axis(const log_linear_axis &) = default;
+  log_linear_axis &operator=(const log_linear_axis &) = default;
+  log_linear_axis(log_linear_axis &&) = default;
+  log_linear_axis &operator=(log_linear_axis &&) = default;
+
+  /// Returns the bin index for the passed argument.
+  inline int index(value_type x) const noexcept {
+    return x > max_ ? bins() : bin(x, p_);
+  }
+
+  /// Returns the starting edge of the bin.
+  value_type operator[](int idx) const {
+    if (idx < 0) {
+      return 0;
+    }
+    const value_type i = idx;
+    if (i >> p_) {
+      const value_type s = (i >> (p_ - 1)) - 1;
+      return (i - (s << (p_ - 1))) << s;
+    }
+    return i;
+  }
+
+  /// Returns the number of significant bits.
+  unsigned significant_bits() const { return p_; }
+  /// Returns the largest value of the covered range.
+  value_type max() const { return max_; }
+
+  bool operator==(const log_linear_axis &o) const {
+    return axis_base<true>::operator==(o) && p_ == o.p_ && max_ == o.max_;
+  }
+
+  const_iterator begin() const {
+    return const_iterator(*this, uoflow() ? -1 : 0);
+  }
+
+  const_iterator end() const {
+    return const_iterator(*this, uoflow() ? bins() + 1 : bins());
+  }
+
+private:
+  unsigned p_ = 1;
+  value_type max_ = 0;
+
+  // at most (65 - p) * 2^(p - 1) bins, which fits into an int for p <= 24
+  static int bin(value_type x, unsigned p) noexcept {
+    const int s = std::max(detail::msb(x | 1) + 1 - static_cast<int>(p), 0);
+    return static_cast<int>((static_cast<value_type>(s) << (p - 1)) +
+                            (x >> s));
+  }
+
+  static int check(unsigned p, value_type max) {
+    if (p < 1 || p > 24 || max >> 63) {
+      throw std::logic_error("1 <= significant_bits <= 24 and max < 2^63 "
+                             "required");
+    }
+    return bin(max, p);
+  }
+
+  template <class Archive>
+  friend void serialize(Archive &, log_linear_axis &, unsigned);
+};
+
 /** An axis for enumerated categories.
  *
  * The axis stores the category labels, and expects that they
  * are addressed using an integer from ``0`` to ``n-1``.
  * There are no underflow/overflow bins for this axis.
  * Binning is a O(1) operation.
+ *
+ * With growth, the storage along the axis is reserved for a power of two
+ * of categories, so that the histogram is only relocated when the number
+ * of categories doubles. shape() includes the reserved bins, which follow
+ * the categories and stay empty. They only size the storage, the size()
+ * and the bin iteration of a histogram leave them out.
  */
 class category_axis : public axis_base<false>, boost::operators<category_axis> {
 public:
@@ -486,63 +1407,110 @@ public:
 
   template <typename Iterator>
   category_axis(Iterator begin, Iterator end,
-                const std::string &label = std::string())
-      : axis_base<false>(std::distance(begin, end), label),
-        ptr_(new std::string[bins()]) {
-    std::copy(begin, end, ptr_.get());
+                const std::string &label = std::string(),
+                bool overflow = false, bool growth = false)
+      : axis_base<false>(std::distance(begin, end), label, growth),
+        cat_(begin, end), overflow_(overflow), growth_(growth) {
+    if (growth && overflow) {
+      throw std::logic_error("growth requires overflow == false");
+    }
+    build_index();
+    update_reserve();
   }
 
   /** Construct from a list of strings.
    *
    * \param categories sequence of labeled categories.
+   * \param label description of the axis.
+   * \param overflow whether to add a bin for unknown categories.
+   * \param growth whether to append unknown categories on first sight,
+   *        which allows to start from an empty list.
    */
   category_axis(const std::initializer_list<std::string> &categories,
-                const std::string &label = std::string())
-      : category_axis(categories.begin(), categories.end(), label) {}
+                const std::string &label = std::string(),
+                bool overflow = false, bool growth = false)
+      : category_axis(categories.begin(), categories.end(), label, overflow,
+                      growth) {}
 
   category_axis() = default;
-
-  category_axis(const category_axis &other)
-      : category_axis(other.ptr_.get(), other.ptr_.get() + other.bins(),
-                      other.label()) {}
-  category_axis &operator=(const category_axis &other) {
-    if (this != &other) {
-      axis_base<false>::operator=(other);
-      ptr_.reset(new std::string[other.bins()]);
-      std::copy(other.ptr_.get(), other.ptr_.get() + other.bins(), ptr_.get());
+  category_axis(const category_axis &) = default;
+  category_axis &operator=(const category_axis &) = default;
+  category_axis(category_axis &&) = default;
+  category_axis &operator=(category_axis &&) = default;
+
+  /// Returns the number of bins, including the overflow and reserved bins.
+  inline int shape() const { return bins() + overflow_ + reserve_; }
+  /// Returns whether unknown categories are counted in an overflow bin.
+  bool overflow() const { return overflow_; }
+  /// Returns whether unknown categories are appended.
+  bool growth() const { return growth_; }
+
+  /** Appends x as a new category, if growth is enabled and x is unknown.
+   *
+   * Indices of existing categories do not change, so the return value, the
+   * number of bins added below, is always zero. The new category takes a
+   * reserved bin if one is left, else the reserve is doubled.
+   */
+  int grow(string_ref x) {
+    if (!growth_ || index(x) < bins()) {
+      return 0;
     }
-    return *this;
+    cat_.emplace_back(x.begin(), x.end());
+    resize(cat_.size());
+    if (2u * cat_.size() > slots_.size()) {
+      build_index();
+    } else {
+      insert(bins() - 1);
+    }
+    update_reserve();
+    return 0;
   }
 
-  category_axis(category_axis &&other)
-      : axis_base<false>(std::move(other)), ptr_(std::move(other.ptr_)) {}
+  /// Returns the bin index for the passed argument, or bins() if out of
+  /// range, which is the overflow bin if present. Without an overflow bin,
+  /// the index is past the reserved bins.
+  inline int index(int x) const noexcept {
+    return (0 <= x && x < bins()) ? x : bins() + reserve_;
+  }
 
-  category_axis &operator=(category_axis &&other) {
-    if (this != &other) {
-      axis_base<false>::operator=(std::move(other));
-      ptr_ = std::move(other.ptr_);
-    }
-    return *this;
+  /// Returns the bin index of the category, or bins() if it is unknown,
+  /// which is the overflow bin if present, see index(int).
+  inline int index(string_ref x) const noexcept {
+    return probe(x, detail::hash_string(x));
   }
 
-  /// Returns the bin index for the passed argument.
-  /// Performs a range check.
-  inline int index(int x) const noexcept {
-    BOOST_ASSERT_MSG(0 <= x && x < bins(),
-                     "category index is out of range");
-    return x;
+  /** Writes the bin indices of the categories [begin, end) to out.
+   *
+   * Hashes a block of keys before probing the table, so that the loads of
+   * the slots for different keys overlap.
+   */
+  template <typename Iterator, typename OutputIterator>
+  void index(Iterator begin, Iterator end, OutputIterator out) const {
+    constexpr unsigned block = 16;
+    std::size_t h[block];
+    while (begin != end) {
+      Iterator it = begin;
+      unsigned n = 0;
+      for (; n < block && it != end; ++n, ++it) {
+        h[n] = detail::hash_string(*it);
+      }
+      for (unsigned i = 0; i < n; ++i, ++begin) {
+        *out++ = probe(*begin, h[i]);
+      }
+    }
   }
 
   /// Returns the category for the bin index.
   value_type operator[](int idx) const {
     BOOST_ASSERT_MSG(0 <= idx && idx < bins(),
                      "category index is out of range");
-    return ptr_.get()[idx];
+    return cat_[idx];
   }
 
   bool operator==(const category_axis &other) const {
     return axis_base<false>::operator==(other) &&
-           std::equal(ptr_.get(), ptr_.get() + bins(), other.ptr_.get());
+           overflow_ == other.overflow_ && growth_ == other.growth_ &&
+           cat_ == other.cat_;
   }
 
   const_iterator begin() const { return const_iterator(*this, 0); }
@@ -550,7 +1518,59 @@ public:
   const_iterator end() const { return const_iterator(*this, bins()); }
 
 private:
-  std::unique_ptr<std::string[]> ptr_;
+  std::vector<std::string> cat_;
+  bool overflow_ = false;
+  bool growth_ = false;
+  // open-addressing table of bin indices, -1 marks an empty slot
+  std::vector<int> slots_;
+  // empty bins after the categories, which a growing axis fills first
+  int reserve_ = 0;
+
+  // a growing axis keeps storage for a power of two of categories
+  void update_reserve() {
+    int n = 1;
+    while (n < bins()) {
+      n *= 2;
+    }
+    reserve_ = growth_ && bins() > 0 ? n - bins() : 0;
+  }
+
+  // sizes the table to a power of two with a load factor of at most 1/2
+  void build_index() {
+    std::size_t n = 8;
+    while (n < 2u * bins()) {
+      n *= 2;
+    }
+    slots_.assign(n, -1);
+    for (int i = 0; i < bins(); ++i) {
+      insert(i);
+    }
+  }
+
+  void insert(int i) {
+    const std::size_t mask = slots_.size() - 1;
+    std::size_t j = detail::hash_string(cat_[i]) & mask;
+    while (slots_[j] >= 0 && cat_[slots_[j]] != cat_[i]) {
+      j = (j + 1) & mask;
+    }
+    if (slots_[j] < 0) { // the first of duplicate categories wins
+      slots_[j] = i;
+    }
+  }
+
+  int probe(string_ref x, std::size_t h) const noexcept {
+    const std::size_t mask = slots_.size() - 1;
+    for (std::size_t j = h & mask; !slots_.empty(); j = (j + 1) & mask) {
+      const int i = slots_[j];
+      if (i < 0) {
+        break;
+      }
+      if (cat_[i] == x) {
+        return i;
+      }
+    }
+    return bins() + reserve_;
+  }
 
   template <class Archive>
   friend void serialize(Archive &, category_axis &, unsigned);
@@ -26,6 +26,55 @@ inline std::ostream &operator<<(std::ostream &os,
   if (!a.uoflow()) {
     os << ", uoflow=False";
   }
+  if (a.growth()) {
+    os << ", growth=True";
+  }
+  os << ")";
+  return os;
+}
+
+template <unsigned N, typename Min, typename Max, bool UOFlow,
+          typename RealType>
+inline std::ostream &
+operator<<(std::ostream &os,
+           const static_regular_axis<N, Min, Max, UOFlow, RealType> &a) {
+  os << "static_regular_axis(" << a.bins() << ", " << a.min() << ", "
+     << a.max();
+  if (!a.label().empty()) {
+    os << ", label=";
+    detail::escape(os, a.label());
+  }
+  if (!a.uoflow()) {
+    os << ", uoflow=False";
+  }
+  os << ")";
+  return os;
+}
+
+inline std::ostream &operator<<(std::ostream &os, const transform::log &) {
+  return os << "log";
+}
+
+inline std::ostream &operator<<(std::ostream &os, const transform::sqrt &) {
+  return os << "sqrt";
+}
+
+inline std::ostream &operator<<(std::ostream &os, const transform::pow &t) {
+  return os << "pow(" << t.power << ")";
+}
+
+template <typename Transform, typename RealType>
+inline std::ostream &operator<<(std::ostream &os,
+                                const transform_axis<Transform, RealType> &a) {
+  os << "transform_axis(" << a.bins() << ", " << a[0] << ", " << a[a.bins()]
+     << ", transform=" << a.transform();
+  if (!a.label().empty()) {
+    os << ", label=";
+    detail::escape(os, a.label());
+  }
+  if (!a.uoflow()) {
+    os << ", uoflow=False";
+  }
   os << ")";
   return os;
 }
@@ -66,6 +115,23 @@ inline std::ostream &operator<<(std::ostream &os,
   return os;
 }
 
+template <typename UInt>
+inline std::ostream &operator<<(std::ostream &os, const lookup_axis<UInt> &a) {
+  os << "lookup_axis(" << a[0];
+  for (int i = 1; i <= a.bins(); ++i) {
+    os << ", " << a[i];
+  }
+  if (!a.label().empty()) {
+    os << ", label=";
+    detail::escape(os, a.label());
+  }
+  if (!a.uoflow()) {
+    os << ", uoflow=False";
+  }
+  os << ")";
+  return os;
+}
+
 inline std::ostream &operator<<(std::ostream &os, const integer_axis &a) {
   os << "integer_axis(" << a[0] << ", " << a[a.bins() - 1];
   if (!a.label().empty()) {
@@ -75,6 +141,35 @@ inline std::ostream &operator<<(std::ostream &os, const integer_axis &a) {
   if (!a.uoflow()) {
     os << ", uoflow=False";
   }
+  if (a.growth()) {
+    os << ", growth=True";
+  }
+  os << ")";
+  return os;
+}
+
+inline std::ostream &operator<<(std::ostream &os, const shift_axis &a) {
+  os << "shift_axis(" << a.bins() << ", " << a[0] << ", " << a.shift();
+  if (!a.label().empty()) {
+    os << ", label=";
+    detail::escape(os, a.label());
+  }
+  if (!a.uoflow()) {
+    os << ", uoflow=False";
+  }
+  os << ")";
+  return os;
+}
+
+inline std::ostream &operator<<(std::ostream &os, const log_linear_axis &a) {
+  os << "log_linear_axis(" << a.significant_bits() << ", " << a.max();
+  if (!a.label().empty()) {
+    os << ", label=";
+    detail::escape(os, a.label());
+  }
+  if (!a.uoflow()) {
+    os << ", uoflow=False";
+  }
   os << ")";
   return os;
 }
@@ -85,9 +180,18 @@ inline std::ostream &operator<<(std::ostream &os, const category_axis &a) {
     detail::escape(os, a[i]);
     os << (i == (a.bins() - 1) ? "" : ", ");
   }
+  // a growable axis may be empty
+  const char *sep = a.bins() ? ", " : "";
   if (!a.label().empty()) {
-    os << ", label=";
+    os << sep << "label=";
     detail::escape(os, a.label());
+    sep = ", ";
+  }
+  if (a.overflow()) {
+    os << sep << "overflow=True";
+  }
+  if (a.growth()) {
+    os << sep << "growth=True";
   }
   os << ")";
   return os;
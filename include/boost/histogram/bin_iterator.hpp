@@ -0,0 +1,135 @@
+// Copyright 2015-2017 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef _BOOST_HISTOGRAM_BIN_ITERATOR_HPP_
+#define _BOOST_HISTOGRAM_BIN_ITERATOR_HPP_
+
+#include <boost/histogram/detail/multi_index.hpp>
+#include <boost/histogram/detail/variance.hpp>
+#include <boost/histogram/histogram_fwd.hpp>
+#include <boost/iterator/iterator_facade.hpp>
+#include <cstddef>
+#include <vector>
+
+namespace boost {
+namespace histogram {
+
+namespace detail {
+template <typename Storage, typename F>
+void for_each_bin(const Storage &s, multi_index &mi, F &f);
+} // namespace detail
+
+/// A bin of a histogram with its per-axis indices, value and variance.
+template <typename Value> class indexed_bin {
+public:
+  indexed_bin() = default;
+  indexed_bin(const detail::multi_index &mi, Value v, Value var)
+      : value(v), variance(var), idx_(mi.begin(), mi.end()) {}
+
+  /// Index of the bin along axis \a i, -1 and bins() denote under-/overflow
+  int idx(unsigned i) const { return idx_[i]; }
+  /// Number of axes
+  unsigned dim() const { return idx_.size(); }
+
+  Value value = Value(0);
+  Value variance = Value(0);
+
+private:
+  // copies the indices of mi, reusing the memory of earlier bins
+  void assign(const detail::multi_index &mi, Value v, Value var) {
+    value = v;
+    variance = var;
+    idx_.assign(mi.begin(), mi.end());
+  }
+
+  std::vector<int> idx_;
+
+  template <typename H> friend class bin_iterator;
+  template <typename S, typename F>
+  friend void detail::for_each_bin(const S &, detail::multi_index &, F &);
+};
+
+/** Iterator over all bins of a histogram, including under-/overflow bins.
+ *
+ * Walks the storage linearly and updates the per-axis indices
+ * incrementally. Bins are visited in storage order, where the first
+ * axis varies fastest. The empty bins that a growing category_axis
+ * reserves are skipped.
+ */
+template <typename Histogram>
+class bin_iterator
+    : public iterator_facade<bin_iterator<Histogram>,
+                             const indexed_bin<typename Histogram::value_type>,
+                             forward_traversal_tag> {
+  using bin_type = indexed_bin<typename Histogram::value_type>;
+
+public:
+  /// Iterator to the i-th bin, counted like size()
+  bin_iterator(const Histogram &h, std::size_t i) : h_(h) {
+    h.for_each_axis(mi_);
+    mi_.set(i);
+  }
+
+private:
+  void increment() { mi_.increment(); }
+  bool equal(const bin_iterator &other) const {
+    return mi_.position() == other.mi_.position();
+  }
+  const bin_type &dereference() const {
+    const std::size_t i = mi_.position();
+    value_.assign(mi_, h_.storage_.value(i), detail::variance(h_.storage_, i));
+    return value_;
+  }
+
+  const Histogram &h_;
+  detail::multi_index mi_;
+  mutable bin_type value_;
+  friend class boost::iterator_core_access;
+};
+
+/// Range over all bins of a histogram.
+template <typename Histogram> class bin_range {
+public:
+  using const_iterator = bin_iterator<Histogram>;
+
+  explicit bin_range(const Histogram &h) : h_(h) {}
+
+  const_iterator begin() const { return const_iterator(h_, 0); }
+  const_iterator end() const { return const_iterator(h_, h_.size()); }
+
+private:
+  const Histogram &h_;
+};
+
+/// Returns a range over all bins of the histogram.
+template <type D, typename A, typename S>
+inline bin_range<histogram<D, A, S>> indexed(const histogram<D, A, S> &h) {
+  return bin_range<histogram<D, A, S>>(h);
+}
+
+namespace detail {
+/// Calls f(indexed_bin) for each bin of a storage with one pass, the
+/// positions that mi skips are passed over
+template <typename Storage, typename F>
+void for_each_bin(const Storage &s, multi_index &mi, F &f) {
+  using value_type = typename Storage::value_type;
+  indexed_bin<value_type> b;
+  storage_for_each(s, 0, s.size(),
+                   [&mi, &f, &b](std::size_t i, value_type v, value_type var) {
+                     if (i != mi.position()) {
+                       return;
+                     }
+                     b.assign(mi, v, var);
+                     f(static_cast<const indexed_bin<value_type> &>(b));
+                     mi.increment();
+                   });
+}
+} // namespace detail
+
+} // namespace histogram
+} // namespace boost
+
+#endif
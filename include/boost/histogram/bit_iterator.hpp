@@ -0,0 +1,46 @@
+// Copyright 2015-2017 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef _BOOST_HISTOGRAM_BIT_ITERATOR_HPP_
+#define _BOOST_HISTOGRAM_BIT_ITERATOR_HPP_
+
+#include <boost/iterator/iterator_facade.hpp>
+#include <cstddef>
+
+namespace boost {
+namespace histogram {
+
+/** Iterator over the bits of a packed mask, to use as the mask of a
+ * masked fill.
+ *
+ * Bit i is bit i % 8 of byte i / 8, counting from the least significant
+ * bit, which is the layout of numpy.packbits with bitorder='little'.
+ */
+class bit_iterator
+    : public iterator_facade<bit_iterator, bool, forward_traversal_tag, bool> {
+public:
+  explicit bit_iterator(const unsigned char *data, std::size_t i = 0)
+      : data_(data), i_(i) {}
+
+private:
+  void increment() { ++i_; }
+
+  bool equal(const bit_iterator &other) const {
+    return data_ == other.data_ && i_ == other.i_;
+  }
+
+  bool dereference() const { return (data_[i_ >> 3] >> (i_ & 7)) & 1; }
+
+  const unsigned char *data_;
+  std::size_t i_;
+
+  friend class boost::iterator_core_access;
+};
+
+} // namespace histogram
+} // namespace boost
+
+#endif
@@ -7,15 +7,18 @@
 #ifndef _BOOST_HISTOGARM_AXIS_VISITOR_HPP_
 #define _BOOST_HISTOGARM_AXIS_VISITOR_HPP_
 
+#include <boost/histogram/axis.hpp>
 #include <boost/histogram/detail/utility.hpp>
 #include <boost/variant/static_visitor.hpp>
 #include <boost/variant.hpp>
 #include <boost/fusion/container/vector.hpp>
+#include <boost/fusion/include/at_c.hpp>
 #include <boost/fusion/include/comparison.hpp>
 #include <boost/fusion/include/size.hpp>
 #include <boost/fusion/include/for_each.hpp>
 #include <boost/mpl/contains.hpp>
 #include <boost/mpl/bool.hpp>
+#include <stdexcept>
 #include <type_traits>
 
 namespace boost {
@@ -30,6 +33,22 @@ struct shape : public static_visitor<int> {
   template <typename A> int operator()(const A &a) const { return a.shape(); }
 };
 
+/// Number of bins along the axis which size() and the bin iteration visit,
+/// the shape without the empty bins a growing category_axis reserves
+template <typename A> int extent(const A &a) { return a.shape(); }
+
+inline int extent(const category_axis &a) {
+  return a.bins() + a.overflow();
+}
+
+struct extent_visitor : public static_visitor<int> {
+  template <typename A> int operator()(const A &a) const { return extent(a); }
+};
+
+template <typename... Axes> int extent(const boost::variant<Axes...> &a) {
+  return apply_visitor(extent_visitor(), a);
+}
+
 struct uoflow : public static_visitor<bool> {
   template <typename A> bool operator()(const A &a) const { return a.uoflow(); }
 };
@@ -40,23 +59,44 @@ template <typename V> struct index : public static_visitor<int> {
   template <typename A> int operator()(const A &a) const { return a.index(v); }
 };
 
+// bin edge as a number, the index for axes with values which are not numbers
+template <typename A>
+typename std::enable_if<std::is_arithmetic<typename std::decay<
+                            typename A::value_type>::type>::value,
+                        double>::type
+edge(const A &a, int i) {
+  return a[i];
+}
+
+template <typename A>
+typename std::enable_if<!std::is_arithmetic<typename std::decay<
+                            typename A::value_type>::type>::value,
+                        double>::type
+edge(const A &, int i) {
+  return i;
+}
+
 struct left : public static_visitor<double> {
   const int i;
   explicit left(const int x) : i(x) {}
-  template <typename A> double operator()(const A &a) const { return a[i]; }
+  template <typename A> double operator()(const A &a) const {
+    return edge(a, i);
+  }
 };
 
 struct right : public static_visitor<double> {
   const int i;
   explicit right(const int x) : i(x) {}
-  template <typename A> double operator()(const A &a) const { return a[i + 1]; }
+  template <typename A> double operator()(const A &a) const {
+    return edge(a, i + 1);
+  }
 };
 
 struct center : public static_visitor<double> {
   const int i;
   explicit center(const int x) : i(x) {}
   template <typename A> double operator()(const A &a) const {
-    return 0.5 * (a[i] + a[i + 1]);
+    return 0.5 * (edge(a, i) + edge(a, i + 1));
   }
 };
 
@@ -141,6 +181,14 @@ struct field_count : public static_visitor<void> {
   }
 };
 
+/// Like field_count, but without the reserved bins, see extent
+struct extent_count : public static_visitor<void> {
+  mutable std::size_t value = 1;
+  template <typename T> void operator()(const T &t) const {
+    value *= extent(t);
+  }
+};
+
 template <typename Unary> struct unary_visitor : public static_visitor<void> {
   Unary &unary;
   unary_visitor(Unary &u) : unary(u) {}
@@ -222,6 +270,52 @@ inline void axes_assign(std::vector<boost::variant<B...>>& a, const fusion::vect
   fusion::for_each(b, fusion_assign_axis2<typename std::vector<boost::variant<B...>>::iterator>(b.begin()));
 }
 
+/// Returns the axis f(a) as a variant, throws if the variant cannot hold it
+template <typename Variant, typename F>
+struct convert_axis : public static_visitor<Variant> {
+  const F &f;
+  explicit convert_axis(const F &fun) : f(fun) {}
+
+  template <typename A> Variant operator()(const A &a) const {
+    using R = decltype(f(a));
+    return impl(typename mpl::contains<typename Variant::types, R>::type(),
+                f(a));
+  }
+
+  template <typename R> Variant impl(mpl::true_, const R &r) const {
+    return Variant(r);
+  }
+
+  template <typename R> Variant impl(mpl::false_, const R &) const {
+    throw std::logic_error("histogram does not support resulting axis type");
+  }
+};
+
+// copies static axes from src to dst, applying f to the N-th axis
+template <unsigned N, unsigned I = 0, typename Dst, typename Src, typename F>
+inline typename std::enable_if<
+    (I == fusion::result_of::size<Dst>::type::value)>::type
+copy_axes_with(Dst &, const Src &, const F &) {}
+
+template <typename D, typename S, typename F>
+inline void assign_axis_with(std::true_type, D &d, const S &s, const F &f) {
+  d = f(s);
+}
+
+template <typename D, typename S, typename F>
+inline void assign_axis_with(std::false_type, D &d, const S &s, const F &) {
+  d = s;
+}
+
+template <unsigned N, unsigned I = 0, typename Dst, typename Src, typename F>
+inline typename std::enable_if<
+    (I < fusion::result_of::size<Dst>::type::value)>::type
+copy_axes_with(Dst &dst, const Src &src, const F &f) {
+  assign_axis_with(std::integral_constant<bool, I == N>(),
+                   fusion::at_c<I>(dst), fusion::at_c<I>(src), f);
+  copy_axes_with<N, I + 1>(dst, src, f);
+}
+
 } // namespace detail
 } // namespace histogram
 } // namespace boost
@@ -0,0 +1,84 @@
+// Copyright 2015-2017 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef _BOOST_HISTOGRAM_DETAIL_GROW_HPP_
+#define _BOOST_HISTOGRAM_DETAIL_GROW_HPP_
+
+#include <boost/histogram/detail/remap.hpp>
+#include <boost/variant/static_visitor.hpp>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace boost {
+namespace histogram {
+namespace detail {
+
+template <typename T, typename Value> struct has_grow {
+  template <typename> static std::false_type test(...);
+
+  template <typename C>
+  static decltype(std::declval<C &>().grow(std::declval<const Value &>()),
+                  std::true_type{})
+  test(int);
+
+  static bool const value = decltype(test<T>(0))::value;
+};
+
+/// Extends a growable axis to include x, returns the bins added below
+template <typename Axis, typename Value>
+typename std::enable_if<has_grow<Axis, Value>::value, int>::type
+grow_axis(Axis &a, const Value &x) {
+  return a.grow(x);
+}
+
+template <typename Axis, typename Value>
+typename std::enable_if<!has_grow<Axis, Value>::value, int>::type
+grow_axis(Axis &, const Value &) {
+  return 0;
+}
+
+template <typename Value> struct grow_visitor : public static_visitor<int> {
+  const Value &x;
+  explicit grow_visitor(const Value &v) : x(v) {}
+  template <typename A> int operator()(A &a) const { return grow_axis(a, x); }
+};
+
+/// Unary functor for for_each_axis which counts the bins of all axes, an
+/// axis may grow into reserved bins without changing its shape
+struct count_bins {
+  int value = 0;
+  template <typename Axis> void operator()(const Axis &a) {
+    value += a.bins();
+  }
+};
+
+/** Remaps which move the content of the old storage into the grown one.
+ *
+ * Growable axes have no under-/overflow bins, so bin j of axis k moves to
+ * j + below[k], where below[k] is the number of bins added in front.
+ */
+inline std::vector<axis_remap> grow_remap(const std::vector<int> &old_shape,
+                                          const std::vector<int> &new_shape,
+                                          const std::vector<int> &below) {
+  std::vector<axis_remap> maps(old_shape.size());
+  std::size_t stride = 1;
+  for (unsigned k = 0; k < maps.size(); ++k) {
+    for (int j = 0; j < old_shape[k]; ++j) {
+      maps[k].pos.push_back(j + below[k]);
+    }
+    maps[k].stride = stride;
+    stride *= new_shape[k];
+  }
+  return maps;
+}
+
+} // namespace detail
+} // namespace histogram
+} // namespace boost
+
+#endif
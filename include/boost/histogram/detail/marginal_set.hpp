@@ -0,0 +1,108 @@
+// Copyright 2015-2017 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef _BOOST_HISTOGRAM_DETAIL_MARGINAL_SET_HPP_
+#define _BOOST_HISTOGRAM_DETAIL_MARGINAL_SET_HPP_
+
+#include <boost/histogram/detail/remap.hpp>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace boost {
+namespace histogram {
+namespace detail {
+
+/** Projections of a histogram which are updated on every fill.
+ *
+ * The histogram computes the storage position along each axis during the
+ * fill and passes them through pos(), so that updating a marginal costs
+ * one multiply-add per kept axis.
+ */
+template <typename Storage> class marginal_set {
+public:
+  using value_type = typename Storage::value_type;
+
+  bool empty() const { return entries_.empty(); }
+
+  /// Buffer for the storage positions of the current entry along each axis
+  int *pos() { return pos_.data(); }
+
+  /// Registers the projection onto the axes keep, initialized from s
+  void add(const Storage &s, const std::vector<int> &shape,
+           const std::vector<unsigned> &keep) {
+    const auto maps = project_remap(shape, keep);
+    if (find(keep)) {
+      return;
+    }
+    entry e;
+    e.keep = keep;
+    std::size_t size = 1;
+    for (const auto k : keep) {
+      e.stride.push_back(maps[k].stride);
+      size *= shape[k];
+    }
+    e.storage = Storage(size);
+    remap(s, maps, e.storage);
+    entries_.push_back(std::move(e));
+    pos_.resize(shape.size());
+  }
+
+  /// Storage of the projection onto the axes keep, or nullptr
+  const Storage *find(const std::vector<unsigned> &keep) const {
+    for (const auto &e : entries_) {
+      if (e.keep == keep) {
+        return &e.storage;
+      }
+    }
+    return nullptr;
+  }
+
+  /// Applies update(storage, i) to the bin i of the entry in each projection
+  template <typename Update> void update(const Update &u) {
+    for (auto &e : entries_) {
+      u(e.storage, index(e));
+    }
+  }
+
+  /// Recomputes all projections from s, after s was modified as a whole
+  void rebuild(const Storage &s, const std::vector<int> &shape) {
+    for (auto &e : entries_) {
+      const auto maps = project_remap(shape, e.keep);
+      std::size_t size = 1;
+      for (unsigned j = 0; j < e.keep.size(); ++j) {
+        e.stride[j] = maps[e.keep[j]].stride;
+        size *= shape[e.keep[j]];
+      }
+      e.storage = Storage(size);
+      remap(s, maps, e.storage);
+    }
+  }
+
+private:
+  struct entry {
+    std::vector<unsigned> keep;
+    std::vector<std::size_t> stride;
+    Storage storage;
+  };
+
+  std::size_t index(const entry &e) const {
+    std::size_t i = 0;
+    for (unsigned j = 0, n = e.keep.size(); j < n; ++j) {
+      i += pos_[e.keep[j]] * e.stride[j];
+    }
+    return i;
+  }
+
+  std::vector<entry> entries_;
+  std::vector<int> pos_;
+};
+
+} // namespace detail
+} // namespace histogram
+} // namespace boost
+
+#endif
@@ -10,7 +10,13 @@
 #include <boost/mpl/not.hpp>
 #include <boost/mpl/contains.hpp>
 #include <boost/mpl/copy_if.hpp>
+#include <boost/mpl/advance.hpp>
+#include <boost/mpl/at.hpp>
 #include <boost/mpl/back_inserter.hpp>
+#include <boost/mpl/begin_end.hpp>
+#include <boost/mpl/erase.hpp>
+#include <boost/mpl/insert.hpp>
+#include <boost/mpl/int.hpp>
 #include <iterator>
 #include <limits>
 #include <type_traits>
@@ -28,6 +34,24 @@ template <typename T> struct has_variance {
   static bool const value = decltype(test<T>(0))::value;
 };
 
+template <typename T> struct has_sample {
+  template <typename> static std::false_type test(...);
+
+  template <typename C>
+  static decltype(std::declval<C &>().sample(0, 0), std::true_type{}) test(int);
+
+  static bool const value = decltype(test<T>(0))::value;
+};
+
+template <typename T> struct has_multi_weight {
+  template <typename> static std::false_type test(...);
+
+  template <typename C>
+  static decltype(std::declval<C &>().value(0, 0u), std::true_type{}) test(int);
+
+  static bool const value = decltype(test<T>(0))::value;
+};
+
 template <typename T, typename = decltype(std::declval<T &>().size(),
                                           std::declval<T &>().increase(0),
                                           std::declval<T &>().value(0))>
@@ -49,6 +73,19 @@ template <typename MainVector, typename AuxVector> struct combine {
     >::type;
 };
 
+/// Sequence with the N-th type replaced by T, unchanged if it already is T
+template <typename Sequence, unsigned N, typename T> class replace_at {
+  template <typename S>
+  using pos = typename mpl::advance<typename mpl::begin<S>::type,
+                                    mpl::int_<N>>::type;
+  using erased = typename mpl::erase<Sequence, pos<Sequence>>::type;
+
+public:
+  using type = typename std::conditional<
+      std::is_same<typename mpl::at_c<Sequence, N>::type, T>::value, Sequence,
+      typename mpl::insert<erased, pos<erased>, T>::type>::type;
+};
+
 } // namespace detail
 } // namespace histogram
 } // namespace boost
@@ -0,0 +1,128 @@
+// Copyright 2015-2017 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef _BOOST_HISTOGRAM_DETAIL_MULTI_INDEX_HPP_
+#define _BOOST_HISTOGRAM_DETAIL_MULTI_INDEX_HPP_
+
+#include <boost/histogram/detail/axis_visitor.hpp>
+#include <boost/histogram/detail/meta.hpp>
+#include <boost/histogram/detail/variance.hpp>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace boost {
+namespace histogram {
+namespace detail {
+
+/** Per-axis bin indices of a position in the linear storage.
+ *
+ * The first axis varies fastest. Along an axis with under-/overflow,
+ * the storage holds bins 0 to bins()-1, then the overflow bin with
+ * index bins(), then the underflow bin with index -1. The empty bins that
+ * a growing category_axis reserves after its bins are skipped, so that
+ * the bins visited are those counted by size().
+ *
+ * Used as a unary functor in for_each_axis to collect the axis shapes.
+ */
+class multi_index {
+public:
+  template <typename Axis> void operator()(const Axis &a) {
+    bins_.push_back(a.bins());
+    extent_.push_back(extent(a));
+    uoflow_.push_back(a.uoflow());
+    stride_.push_back(size_);
+    size_ *= a.shape();
+    pos_.push_back(0);
+    idx_.push_back(0);
+  }
+
+  unsigned dim() const { return idx_.size(); }
+  int idx(unsigned k) const { return idx_[k]; }
+  const int *begin() const { return idx_.data(); }
+  const int *end() const { return idx_.data() + idx_.size(); }
+  int bins(unsigned k) const { return bins_[k]; }
+  /// Linear storage position of the current bin, the storage size past
+  /// the last bin
+  std::size_t position() const { return i_; }
+
+  /// Set indices to those of the i-th visited bin
+  void set(std::size_t i) {
+    i_ = 0;
+    for (unsigned k = 0, n = dim(); k < n; ++k) {
+      const std::size_t e = extent_[k];
+      pos_[k] = e ? i % e : 0;
+      i = e ? i / e : 0;
+      i_ += pos_[k] * stride_[k];
+      update(k);
+    }
+    if (i > 0) {
+      i_ = size_;
+    }
+  }
+
+  /// Advance to the next visited bin, without division
+  void increment() {
+    for (unsigned k = 0, n = dim(); k < n; ++k) {
+      if (++pos_[k] < extent_[k]) {
+        i_ += stride_[k];
+        update(k);
+        return;
+      }
+      i_ -= (pos_[k] - 1) * stride_[k];
+      pos_[k] = 0;
+      idx_[k] = 0;
+    }
+    i_ = size_;
+  }
+
+private:
+  void update(unsigned k) {
+    // position bins()+1 holds the underflow bin
+    idx_[k] = pos_[k] - (uoflow_[k] && pos_[k] > bins_[k]) * (bins_[k] + 2);
+  }
+
+  std::vector<int> bins_, extent_, uoflow_, pos_, idx_;
+  std::vector<std::size_t> stride_;
+  std::size_t size_ = 1, i_ = 0;
+};
+
+template <typename T> struct has_for_each {
+  template <typename> static std::false_type test(...);
+
+  template <typename C>
+  static decltype(std::declval<const C &>().for_each(
+                      0, 0, std::declval<void (*)(std::size_t, double,
+                                                  double)>()),
+                  std::true_type{})
+  test(int);
+
+  static bool const value = decltype(test<T>(0))::value;
+};
+
+/// Calls f(i, value, variance) for each bin i in [begin, end) of a storage
+template <typename Storage, typename F>
+typename std::enable_if<has_for_each<Storage>::value>::type
+storage_for_each(const Storage &s, std::size_t begin, std::size_t end,
+                 F &&f) {
+  s.for_each(begin, end, std::forward<F>(f));
+}
+
+template <typename Storage, typename F>
+typename std::enable_if<!has_for_each<Storage>::value>::type
+storage_for_each(const Storage &s, std::size_t begin, std::size_t end,
+                 F &&f) {
+  for (std::size_t i = begin; i < end; ++i) {
+    f(i, s.value(i), variance(s, i));
+  }
+}
+
+} // namespace detail
+} // namespace histogram
+} // namespace boost
+
+#endif
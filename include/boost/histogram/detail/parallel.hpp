@@ -0,0 +1,55 @@
+// Copyright 2015-2017 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef _BOOST_HISTOGRAM_DETAIL_PARALLEL_HPP_
+#define _BOOST_HISTOGRAM_DETAIL_PARALLEL_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace boost {
+namespace histogram {
+namespace detail {
+
+/// Number of chunks that parallel_for splits a range of size n into
+inline unsigned parallel_chunks(std::size_t n, std::size_t grain) {
+  const std::size_t nthreads =
+      std::max(std::thread::hardware_concurrency(), 1u);
+  return static_cast<unsigned>(std::max<std::size_t>(
+      1, std::min(nthreads, grain ? n / grain : nthreads)));
+}
+
+/** Calls f(chunk, begin, end) for contiguous chunks of [0, n) in parallel.
+ *
+ * Ranges smaller than 2 * grain are processed in the calling thread.
+ * The functor must not throw.
+ */
+template <typename F>
+void parallel_for(std::size_t n, std::size_t grain, F &&f) {
+  const unsigned nchunks = parallel_chunks(n, grain);
+  if (nchunks < 2) {
+    f(0u, std::size_t(0), n);
+    return;
+  }
+  std::vector<std::thread> threads;
+  threads.reserve(nchunks - 1);
+  const std::size_t step = n / nchunks;
+  for (unsigned k = 0; k + 1 < nchunks; ++k) {
+    threads.emplace_back([&f, k, step] { f(k, k * step, (k + 1) * step); });
+  }
+  f(nchunks - 1, (nchunks - 1) * step, n);
+  for (auto &t : threads) {
+    t.join();
+  }
+}
+
+} // namespace detail
+} // namespace histogram
+} // namespace boost
+
+#endif
@@ -0,0 +1,158 @@
+// Copyright 2015-2017 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef _BOOST_HISTOGRAM_DETAIL_REBIN_HPP_
+#define _BOOST_HISTOGRAM_DETAIL_REBIN_HPP_
+
+#include <boost/histogram/axis.hpp>
+#include <boost/histogram/detail/remap.hpp>
+#include <stdexcept>
+#include <vector>
+
+namespace boost {
+namespace histogram {
+namespace detail {
+
+// Axes with every factor adjacent bins merged into one. Bins left over at
+// the upper end are outside of the new range.
+
+template <typename RealType>
+regular_axis<RealType> rebin_axis(const regular_axis<RealType> &a,
+                                  unsigned factor) {
+  const int n = a.bins() / factor;
+  return regular_axis<RealType>(n, a[0], a[n * factor], a.label(),
+                                a.uoflow(), a.growth());
+}
+
+// the merged bins are no longer known at compile time
+template <unsigned N, typename Min, typename Max, bool UOFlow,
+          typename RealType>
+regular_axis<RealType>
+rebin_axis(const static_regular_axis<N, Min, Max, UOFlow, RealType> &a,
+           unsigned factor) {
+  const int n = a.bins() / factor;
+  return regular_axis<RealType>(n, a[0], a[n * factor], a.label(), UOFlow);
+}
+
+template <typename Transform, typename RealType>
+transform_axis<Transform, RealType>
+rebin_axis(const transform_axis<Transform, RealType> &a, unsigned factor) {
+  const int n = a.bins() / factor;
+  return transform_axis<Transform, RealType>(n, a[0], a[n * factor], a.label(),
+                                             a.uoflow(), a.transform());
+}
+
+template <typename RealType>
+circular_axis<RealType> rebin_axis(const circular_axis<RealType> &a,
+                                   unsigned factor) {
+  if (a.bins() % factor) {
+    throw std::logic_error("factor must divide bins of circular axis");
+  }
+  return circular_axis<RealType>(a.bins() / factor, a.phase(), a.perimeter(),
+                                 a.label());
+}
+
+template <typename RealType>
+variable_axis<RealType> rebin_axis(const variable_axis<RealType> &a,
+                                   unsigned factor) {
+  std::vector<RealType> x;
+  for (int i = 0, n = a.bins() / factor; i <= n; ++i) {
+    x.push_back(a[i * factor]);
+  }
+  return variable_axis<RealType>(x.begin(), x.end(), a.label(), a.uoflow());
+}
+
+template <typename UInt>
+lookup_axis<UInt> rebin_axis(const lookup_axis<UInt> &a, unsigned factor) {
+  std::vector<int> x;
+  for (int i = 0, n = a.bins() / factor; i <= n; ++i) {
+    x.push_back(a[i * factor]);
+  }
+  return lookup_axis<UInt>(x.begin(), x.end(), a.label(), a.uoflow());
+}
+
+// merged integers are no longer addressed by a single value
+inline regular_axis<double> rebin_axis(const integer_axis &a,
+                                       unsigned factor) {
+  const int n = a.bins() / factor;
+  return regular_axis<double>(n, a[0], a[0] + n * int(factor), a.label(),
+                              a.uoflow(), a.growth());
+}
+
+inline shift_axis rebin_axis(const shift_axis &a, unsigned factor) {
+  if (factor & (factor - 1)) {
+    throw std::logic_error("shift_axis can only be rebinned by a power of two");
+  }
+  unsigned s = a.shift();
+  while (factor >>= 1) {
+    ++s;
+  }
+  return shift_axis(a.bins() >> (s - a.shift()), a[0], s, a.label(),
+                    a.uoflow());
+}
+
+inline category_axis rebin_axis(const category_axis &, unsigned) {
+  throw std::logic_error("category axis cannot be rebinned");
+}
+
+template <typename Axis>
+using rebinned_axis =
+    decltype(rebin_axis(std::declval<const Axis &>(), 0u));
+
+/// Axis transform for copy_axes_with and convert_axis
+struct rebin_axis_fn {
+  unsigned factor;
+  template <typename Axis>
+  rebinned_axis<Axis> operator()(const Axis &a) const {
+    return rebin_axis(a, factor);
+  }
+};
+
+/// Remaps that merge every factor adjacent bins along axis k
+inline std::vector<axis_remap> rebin_remap(const std::vector<int> &shape,
+                                           unsigned k, int bins,
+                                           unsigned factor) {
+  if (k >= shape.size()) {
+    throw std::out_of_range("axis index out of range");
+  }
+  if (factor == 0) {
+    throw std::logic_error("factor > 0 required");
+  }
+  const int n = bins / factor;
+  if (n == 0) {
+    throw std::logic_error("factor must not exceed number of bins");
+  }
+  const bool uoflow = shape[k] > bins;
+  std::vector<axis_remap> maps(shape.size());
+  std::size_t stride = 1;
+  for (unsigned i = 0; i < maps.size(); ++i) {
+    auto &m = maps[i];
+    m.stride = stride;
+    if (i != k) {
+      for (int j = 0; j < shape[i]; ++j) {
+        m.pos.push_back(j);
+      }
+      stride *= shape[i];
+      continue;
+    }
+    const int merged = n * factor;
+    for (int j = 0; j < bins; ++j) {
+      m.pos.push_back(j < merged ? j / int(factor) : (uoflow ? n : -1));
+    }
+    if (uoflow) {
+      m.pos.push_back(n);     // overflow
+      m.pos.push_back(n + 1); // underflow
+    }
+    stride *= n + 2 * uoflow;
+  }
+  return maps;
+}
+
+} // namespace detail
+} // namespace histogram
+} // namespace boost
+
+#endif
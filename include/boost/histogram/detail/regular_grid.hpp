@@ -0,0 +1,90 @@
+// Copyright 2015-2017 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef _BOOST_HISTOGRAM_DETAIL_REGULAR_GRID_HPP_
+#define _BOOST_HISTOGRAM_DETAIL_REGULAR_GRID_HPP_
+
+#include <boost/histogram/axis.hpp>
+#include <boost/mpl/begin_end.hpp>
+#include <boost/mpl/find_if.hpp>
+#include <boost/mpl/not.hpp>
+#include <boost/variant/static_visitor.hpp>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace boost {
+namespace histogram {
+namespace detail {
+
+template <typename T> struct is_regular_axis : std::false_type {};
+
+template <typename RealType>
+struct is_regular_axis<regular_axis<RealType>> : std::true_type {};
+
+/// Whether all axes in the sequence are regular_axis
+template <typename Axes>
+struct all_regular
+    : std::is_same<typename mpl::find_if<
+                       Axes, mpl::not_<is_regular_axis<mpl::_1>>>::type,
+                   typename mpl::end<Axes>::type> {};
+
+// number of entries that grid_index processes at once
+constexpr unsigned grid_block = 64;
+
+/** Adds the storage positions along axis a of the next m entries to pos.
+ *
+ * The bin indices come from the batch index of the axis, the wrap of the
+ * underflow bin and the multiply-add with the stride are one loop without
+ * branches over the block. ok[i] is cleared for entries outside of the
+ * axis, so that the caller checks the range once per entry.
+ */
+template <typename Axis, typename Iterator>
+inline void grid_index(const Axis &a, Iterator &it, unsigned m,
+                       std::size_t &stride, std::size_t *pos, int *ok) {
+  int j[grid_block];
+  const Iterator end = std::next(it, m);
+  a.index(it, end, j);
+  it = end;
+  const int wrap = a.bins() + 2, shape = a.shape();
+  for (unsigned i = 0; i < m; ++i) {
+    const int k = j[i] + (j[i] < 0) * wrap;
+    ok[i] &= k < shape;
+    pos[i] += k * stride;
+  }
+  stride *= shape;
+}
+
+// a.growth() if the axis has it, else false
+template <typename A>
+inline auto axis_growth(const A &a, int) -> decltype(a.growth()) {
+  return a.growth();
+}
+
+template <typename A> inline bool axis_growth(const A &, long) {
+  return false;
+}
+
+// sets value to true if an axis grows
+struct any_growth {
+  bool value = false;
+  template <typename Axis> void operator()(const Axis &a) {
+    value |= axis_growth(a, 0);
+  }
+};
+
+// whether an axis in a variant grows
+struct growth_visitor : public static_visitor<bool> {
+  template <typename A> bool operator()(const A &a) const {
+    return axis_growth(a, 0);
+  }
+};
+
+} // namespace detail
+} // namespace histogram
+} // namespace boost
+
+#endif
@@ -0,0 +1,281 @@
+// Copyright 2015-2017 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef _BOOST_HISTOGRAM_DETAIL_REMAP_HPP_
+#define _BOOST_HISTOGRAM_DETAIL_REMAP_HPP_
+
+#include <algorithm>
+#include <boost/histogram/detail/multi_index.hpp>
+#include <boost/histogram/detail/parallel.hpp>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace boost {
+namespace histogram {
+namespace detail {
+
+/** Maps the storage positions of one source axis onto a target storage.
+ *
+ * pos[j] is the target position of source position j, or -1 if the content
+ * at that position is dropped. The target position is multiplied by the
+ * stride, which is zero for an axis that is summed over.
+ */
+struct axis_remap {
+  std::vector<int> pos;
+  std::size_t stride = 0;
+};
+
+/// Unary functor for for_each_axis which collects the axis shapes
+struct collect_shapes {
+  std::vector<int> value;
+  template <typename Axis> void operator()(const Axis &a) {
+    value.push_back(a.shape());
+  }
+};
+
+template <typename T> struct has_add {
+  template <typename> static std::false_type test(...);
+
+  template <typename C>
+  static decltype(std::declval<C &>().add(0, 0.0, 0.0), std::true_type{})
+  test(int);
+
+  static bool const value = decltype(test<T>(0))::value;
+};
+
+/// Adds value and variance to bin i of a storage
+template <typename Storage>
+typename std::enable_if<has_add<Storage>::value>::type
+storage_add(Storage &s, std::size_t i, double value, double variance) {
+  s.add(i, value, variance);
+}
+
+template <typename Storage>
+typename std::enable_if<!has_add<Storage>::value>::type
+storage_add(Storage &s, std::size_t i, double value, double /*variance*/) {
+  s.increase(i, value);
+}
+
+/// Remaps that keep the axes with indices in keep, in that order
+inline std::vector<axis_remap> project_remap(const std::vector<int> &shape,
+                                             const std::vector<unsigned> &keep) {
+  if (keep.empty()) {
+    throw std::logic_error("at least one axis required");
+  }
+  std::vector<axis_remap> maps(shape.size());
+  for (unsigned k = 0; k < maps.size(); ++k) {
+    maps[k].pos.assign(shape[k], 0);
+  }
+  std::size_t stride = 1;
+  for (const auto k : keep) {
+    if (k >= maps.size()) {
+      throw std::out_of_range("axis index out of range");
+    }
+    if (maps[k].stride) {
+      throw std::logic_error("axis index appears more than once");
+    }
+    for (int j = 0; j < shape[k]; ++j) {
+      maps[k].pos[j] = j;
+    }
+    maps[k].stride = stride;
+    stride *= shape[k];
+  }
+  return maps;
+}
+
+// accumulates [begin, end) of the source into interleaved value/variance sums
+template <typename Storage>
+void remap_range(const Storage &src,
+                 const std::vector<std::vector<std::ptrdiff_t>> &off,
+                 std::size_t begin, std::size_t end, double *acc) {
+  if (begin == end) { // the source may have an axis without bins
+    return;
+  }
+  const unsigned dim = off.size();
+  std::vector<std::size_t> cnt(dim);
+  std::size_t i = begin;
+  for (unsigned k = 0; k < dim; ++k) {
+    cnt[k] = i % off[k].size();
+    i /= off[k].size();
+  }
+  // offset of all axes except the first, negative if the row is dropped
+  auto row_offset = [&off, &cnt, dim] {
+    std::ptrdiff_t r = 0;
+    for (unsigned k = 1; k < dim; ++k) {
+      const auto o = off[k][cnt[k]];
+      if (o < 0) {
+        return std::ptrdiff_t(-1);
+      }
+      r += o;
+    }
+    return r;
+  };
+  std::ptrdiff_t row = row_offset();
+  const std::vector<std::ptrdiff_t> &off0 = off[0];
+  const std::size_t shape0 = off0.size();
+  std::size_t &c0 = cnt[0];
+  storage_for_each(src, begin, end,
+                   [&](std::size_t, double value, double variance) {
+                     const auto o = off0[c0];
+                     if (row >= 0 && o >= 0) {
+                       double *x = acc + 2 * (row + o);
+                       x[0] += value;
+                       x[1] += variance;
+                     }
+                     if (++c0 == shape0) {
+                       c0 = 0;
+                       for (unsigned k = 1; k < dim; ++k) {
+                         if (++cnt[k] < off[k].size()) {
+                           break;
+                         }
+                         cnt[k] = 0;
+                       }
+                       row = row_offset();
+                     }
+                   });
+}
+
+template <typename S1, typename S2> struct has_bin_add {
+  template <typename, typename> static std::false_type test(...);
+
+  template <typename C1, typename C2>
+  static decltype(std::declval<C2 &>().add(0, std::declval<const C1 &>().bin(0)),
+                  std::true_type{})
+  test(int);
+
+  static bool const value = decltype(test<S1, S2>(0))::value;
+};
+
+// calls f(i, t) for each position i of the source with target position t
+template <typename F>
+void for_each_remapped(std::size_t n,
+                       const std::vector<std::vector<std::ptrdiff_t>> &off,
+                       F &&f) {
+  const unsigned dim = off.size();
+  std::vector<std::size_t> cnt(dim, 0);
+  for (std::size_t i = 0; i < n; ++i) {
+    std::ptrdiff_t t = 0;
+    for (unsigned k = 0; k < dim && t >= 0; ++k) {
+      const auto o = off[k][cnt[k]];
+      t = o < 0 ? -1 : t + o;
+    }
+    if (t >= 0) {
+      f(i, t);
+    }
+    for (unsigned k = 0; k < dim; ++k) {
+      if (++cnt[k] < off[k].size()) {
+        break;
+      }
+      cnt[k] = 0;
+    }
+  }
+}
+
+// moves whole bins, for storages which hold more than a value and a variance
+template <typename S1, typename S2>
+void remap_impl(std::true_type, const S1 &src,
+                const std::vector<std::vector<std::ptrdiff_t>> &off, S2 &dst) {
+  for_each_remapped(src.size(), off,
+                    [&src, &dst](std::size_t i, std::size_t t) {
+                      dst.add(t, src.bin(i));
+                    });
+}
+
+template <typename S1, typename S2> struct has_exact_add {
+  template <typename, typename> static std::false_type test(...);
+
+  template <typename C1, typename C2>
+  static decltype(std::declval<C2 &>().add(0, std::declval<const C1 &>(), 0),
+                  std::declval<const C1 &>().large_counts(), std::true_type{})
+  test(int);
+
+  static bool const value = decltype(test<S1, S2>(0))::value;
+};
+
+// adds bin by bin, if the counts of src are too large for double sums
+template <typename S1, typename S2>
+typename std::enable_if<has_exact_add<S1, S2>::value, bool>::type
+remap_exact(const S1 &src, const std::vector<std::vector<std::ptrdiff_t>> &off,
+            S2 &dst) {
+  if (!src.large_counts()) {
+    return false;
+  }
+  for_each_remapped(src.size(), off,
+                    [&src, &dst](std::size_t i, std::size_t t) {
+                      dst.add(t, src, i);
+                    });
+  return true;
+}
+
+template <typename S1, typename S2>
+typename std::enable_if<!has_exact_add<S1, S2>::value, bool>::type
+remap_exact(const S1 &, const std::vector<std::vector<std::ptrdiff_t>> &,
+            S2 &) {
+  return false;
+}
+
+/** Remaps the values and variances of src into dst.
+ *
+ * The source storage is traversed once in linear order. Large inputs are
+ * split into chunks which are processed in parallel, each into its own
+ * accumulator, which are summed at the end.
+ */
+template <typename S1, typename S2>
+void remap_impl(std::false_type, const S1 &src,
+                const std::vector<std::vector<std::ptrdiff_t>> &off, S2 &dst) {
+  const std::size_t n = src.size(), m = dst.size();
+  // chunks must be large compared to the accumulators they need
+  const std::size_t grain = std::max<std::size_t>(1 << 16, 4 * m);
+  const unsigned nchunks = parallel_chunks(n, grain);
+  std::vector<double> acc(2 * m * nchunks, 0.0);
+  parallel_for(n, grain,
+               [&](unsigned c, std::size_t begin, std::size_t end) {
+                 remap_range(src, off, begin, end, acc.data() + 2 * m * c);
+               });
+  for (unsigned c = 1; c < nchunks; ++c) {
+    const double *x = acc.data() + 2 * m * c;
+    for (std::size_t t = 0; t < 2 * m; ++t) {
+      acc[t] += x[t];
+    }
+  }
+  for (std::size_t t = 0; t < m; ++t) {
+    if (acc[2 * t] != 0 || acc[2 * t + 1] != 0) {
+      storage_add(dst, t, acc[2 * t], acc[2 * t + 1]);
+    }
+  }
+}
+
+/** Adds the content of src to dst, moving each bin to its remapped position.
+ *
+ * Storages whose bins hold more than a value and a variance, like
+ * profile_storage, provide bin(i) and add(i, bin) and are remapped bin by
+ * bin, so that nothing but the position of the bin changes. Storages with
+ * add(i, src, j) and large_counts(), like adaptive_storage, are remapped bin
+ * by bin when the counts are too large to be summed exactly in doubles.
+ */
+template <typename S1, typename S2>
+void remap(const S1 &src, const std::vector<axis_remap> &maps, S2 &dst) {
+  std::vector<std::vector<std::ptrdiff_t>> off(maps.size());
+  for (unsigned k = 0; k < maps.size(); ++k) {
+    off[k].reserve(maps[k].pos.size());
+    for (const auto j : maps[k].pos) {
+      off[k].push_back(j < 0 ? -1 : std::ptrdiff_t(j * maps[k].stride));
+    }
+  }
+  if (!remap_exact(src, off, dst)) {
+    remap_impl(std::integral_constant<bool, has_bin_add<S1, S2>::value>(), src,
+               off, dst);
+  }
+}
+
+} // namespace detail
+} // namespace histogram
+} // namespace boost
+
+#endif
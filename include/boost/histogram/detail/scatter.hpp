@@ -0,0 +1,111 @@
+// Copyright 2015-2017 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef _BOOST_HISTOGRAM_DETAIL_SCATTER_HPP_
+#define _BOOST_HISTOGRAM_DETAIL_SCATTER_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace boost {
+namespace histogram {
+namespace detail {
+
+// calls s.prefetch(i) if the storage has it
+template <typename S>
+inline auto storage_prefetch(const S &s, std::size_t i, int)
+    -> decltype(s.prefetch(i)) {
+  s.prefetch(i);
+}
+
+template <typename S>
+inline void storage_prefetch(const S &, std::size_t, long) {}
+
+/// Increases s at pos[i] for all i < m with ok[i] != 0, in order
+template <typename Storage>
+void direct_increase(Storage &s, const std::size_t *pos, const int *ok,
+                     std::size_t m) {
+  for (std::size_t i = 0; i < m; ++i) {
+    if (ok[i]) {
+      s.increase(pos[i]);
+    }
+  }
+}
+
+// entries between a prefetch and the increase of its bin
+constexpr std::size_t prefetch_distance = 16;
+
+/** Like direct_increase, but prefetches the bin of the entry
+ * prefetch_distance places ahead, so that several cache misses are in
+ * flight at once. Entries which are not ok have no bin and are not
+ * prefetched.
+ */
+template <typename Storage>
+void prefetch_increase(Storage &s, const std::size_t *pos, const int *ok,
+                       std::size_t m) {
+  for (std::size_t i = 0; i < m; ++i) {
+    if (i + prefetch_distance < m && ok[i + prefetch_distance]) {
+      storage_prefetch(s, pos[i + prefetch_distance], 0);
+    }
+    if (ok[i]) {
+      s.increase(pos[i]);
+    }
+  }
+}
+
+/** Applies increments grouped by ranges of 2^shift bins.
+ *
+ * The positions of a block are partitioned by pos >> shift in one counting
+ * pass and one scatter pass, and then applied bucket by bucket, with
+ * prefetches as in prefetch_increase. The bins of a bucket span a few
+ * pages, which stay in the cache and the TLB while the bucket is
+ * processed. Only ok entries are sorted, so every prefetch hits the
+ * storage. The buffers are kept between blocks.
+ */
+class bucket_scatter {
+public:
+  // 2^12 bins of up to 8 bytes are eight 4k pages
+  explicit bucket_scatter(std::size_t size, unsigned shift = 12)
+      : shift_(shift), count_((size >> shift) + 2) {}
+
+  template <typename Storage>
+  void increase(Storage &s, const std::size_t *pos, const int *ok,
+                std::size_t m) {
+    std::fill(count_.begin(), count_.end(), 0);
+    for (std::size_t i = 0; i < m; ++i) {
+      if (ok[i]) {
+        ++count_[(pos[i] >> shift_) + 1];
+      }
+    }
+    for (std::size_t b = 1; b < count_.size(); ++b) {
+      count_[b] += count_[b - 1];
+    }
+    sorted_.resize(count_.back());
+    for (std::size_t i = 0; i < m; ++i) {
+      if (ok[i]) {
+        sorted_[count_[pos[i] >> shift_]++] = pos[i];
+      }
+    }
+    for (std::size_t i = 0, n = sorted_.size(); i < n; ++i) {
+      if (i + prefetch_distance < n) {
+        storage_prefetch(s, sorted_[i + prefetch_distance], 0);
+      }
+      s.increase(sorted_[i]);
+    }
+  }
+
+private:
+  unsigned shift_;
+  std::vector<std::size_t> count_;
+  std::vector<std::size_t> sorted_;
+};
+
+} // namespace detail
+} // namespace histogram
+} // namespace boost
+
+#endif
@@ -0,0 +1,174 @@
+// Copyright 2015-2017 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef _BOOST_HISTOGRAM_DETAIL_SLICE_HPP_
+#define _BOOST_HISTOGRAM_DETAIL_SLICE_HPP_
+
+#include <boost/histogram/axis.hpp>
+#include <boost/histogram/detail/remap.hpp>
+#include <boost/variant/static_visitor.hpp>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace boost {
+namespace histogram {
+namespace detail {
+
+// Axes which keep only the bins [begin, end)
+
+template <typename RealType>
+regular_axis<RealType> slice_axis(const regular_axis<RealType> &a, int begin,
+                                  int end) {
+  return regular_axis<RealType>(end - begin, a[begin], a[end], a.label(),
+                                a.uoflow(), a.growth());
+}
+
+template <unsigned N, typename Min, typename Max, bool UOFlow,
+          typename RealType>
+regular_axis<RealType>
+slice_axis(const static_regular_axis<N, Min, Max, UOFlow, RealType> &a,
+           int begin, int end) {
+  return regular_axis<RealType>(end - begin, a[begin], a[end], a.label(),
+                                UOFlow);
+}
+
+template <typename Transform, typename RealType>
+transform_axis<Transform, RealType>
+slice_axis(const transform_axis<Transform, RealType> &a, int begin, int end) {
+  return transform_axis<Transform, RealType>(
+      end - begin, a[begin], a[end], a.label(), a.uoflow(), a.transform());
+}
+
+// a sub-range of a circular axis no longer wraps around
+template <typename RealType>
+regular_axis<RealType> slice_axis(const circular_axis<RealType> &a, int begin,
+                                  int end) {
+  return regular_axis<RealType>(end - begin, a[begin], a[end], a.label(),
+                                false);
+}
+
+template <typename RealType>
+variable_axis<RealType> slice_axis(const variable_axis<RealType> &a,
+                                   int begin, int end) {
+  std::vector<RealType> x;
+  for (int i = begin; i <= end; ++i) {
+    x.push_back(a[i]);
+  }
+  return variable_axis<RealType>(x.begin(), x.end(), a.label(), a.uoflow());
+}
+
+template <typename UInt>
+lookup_axis<UInt> slice_axis(const lookup_axis<UInt> &a, int begin, int end) {
+  std::vector<int> x;
+  for (int i = begin; i <= end; ++i) {
+    x.push_back(a[i]);
+  }
+  return lookup_axis<UInt>(x.begin(), x.end(), a.label(), a.uoflow());
+}
+
+inline integer_axis slice_axis(const integer_axis &a, int begin, int end) {
+  return integer_axis(a[begin], a[end - 1], a.label(), a.uoflow(),
+                      a.growth());
+}
+
+inline shift_axis slice_axis(const shift_axis &a, int begin, int end) {
+  return shift_axis(end - begin, a[begin], a.shift(), a.label(), a.uoflow());
+}
+
+inline category_axis slice_axis(const category_axis &a, int begin, int end) {
+  std::vector<std::string> c;
+  for (int i = begin; i < end; ++i) {
+    c.push_back(a[i]);
+  }
+  return category_axis(c.begin(), c.end(), a.label(), a.overflow(),
+                       a.growth());
+}
+
+template <typename Axis>
+using sliced_axis = decltype(slice_axis(std::declval<const Axis &>(), 0, 0));
+
+/// Axis transform for copy_axes_with and convert_axis
+struct slice_axis_fn {
+  int begin, end;
+  template <typename Axis> sliced_axis<Axis> operator()(const Axis &a) const {
+    return slice_axis(a, begin, end);
+  }
+};
+
+// whether the axis has an overflow bin, a category_axis may have one
+// without an underflow bin
+template <typename A> bool has_overflow(const A &a) { return a.uoflow(); }
+
+inline bool has_overflow(const category_axis &a) { return a.overflow(); }
+
+struct overflow_visitor : public static_visitor<bool> {
+  template <typename A> bool operator()(const A &a) const {
+    return has_overflow(a);
+  }
+};
+
+/// Throws unless [begin, end) is a non-empty range of the bins
+inline void check_slice(int bins, int begin, int end) {
+  if (begin < 0 || end > bins || !(begin < end)) {
+    throw std::out_of_range("invalid bin range");
+  }
+}
+
+/** Remaps that keep the bins [begin, end) along axis k, from a storage
+ * with shape to one with shape sliced.
+ *
+ * Bins below begin go into the underflow bin, bins at or above end into the
+ * overflow bin. An axis with only an overflow bin collects both there, and
+ * an axis with neither drops them. The empty bins that a growing axis
+ * reserves after its bins are dropped.
+ */
+inline std::vector<axis_remap>
+slice_remap(const std::vector<int> &shape, const std::vector<int> &sliced,
+            unsigned k, int bins, int begin, int end, bool underflow,
+            bool overflow) {
+  if (k >= shape.size()) {
+    throw std::out_of_range("axis index out of range");
+  }
+  check_slice(bins, begin, end);
+  const int n = end - begin;
+  std::vector<axis_remap> maps(shape.size());
+  std::size_t stride = 1;
+  for (unsigned i = 0; i < maps.size(); ++i) {
+    auto &m = maps[i];
+    m.stride = stride;
+    stride *= sliced[i];
+    if (i != k) {
+      for (int j = 0; j < shape[i]; ++j) {
+        m.pos.push_back(j);
+      }
+      continue;
+    }
+    for (int j = 0; j < bins; ++j) {
+      if (j < begin) {
+        m.pos.push_back(underflow ? n + 1 : overflow ? n : -1);
+      } else if (j < end) {
+        m.pos.push_back(j - begin);
+      } else {
+        m.pos.push_back(overflow ? n : -1);
+      }
+    }
+    if (overflow) {
+      m.pos.push_back(n);
+    }
+    if (underflow) {
+      m.pos.push_back(n + 1);
+    }
+    m.pos.resize(shape[k], -1);
+  }
+  return maps;
+}
+
+} // namespace detail
+} // namespace histogram
+} // namespace boost
+
+#endif
@@ -0,0 +1,142 @@
+// Copyright 2015-2017 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef _BOOST_HISTOGRAM_DETAIL_SUMMED_AREA_HPP_
+#define _BOOST_HISTOGRAM_DETAIL_SUMMED_AREA_HPP_
+
+#include <algorithm>
+#include <boost/histogram/detail/parallel.hpp>
+#include <boost/histogram/detail/remap.hpp>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace boost {
+namespace histogram {
+namespace detail {
+
+/** Summed-area table of the values and variances of a histogram.
+ *
+ * Bins are ordered naturally, underflow first and overflow last, and the
+ * table is padded with a leading zero along each axis, so that entry c
+ * holds the sum over all bins with coordinates below c. A sum over a box
+ * then takes 2^dim lookups.
+ *
+ * Used as a unary functor in for_each_axis to collect the axis layout.
+ */
+class summed_area {
+public:
+  template <typename Axis> void operator()(const Axis &a) {
+    bins_.push_back(a.bins());
+    shape_.push_back(a.shape());
+    uoflow_.push_back(a.uoflow());
+  }
+
+  unsigned dim() const { return bins_.size(); }
+
+  /// Fills the table from storage s, in one pass and one scan per axis
+  template <typename Storage> void build(const Storage &s) {
+    const unsigned dim = bins_.size();
+    std::vector<std::vector<std::ptrdiff_t>> off(dim);
+    std::size_t size = 1;
+    stride_.resize(dim);
+    for (unsigned k = 0; k < dim; ++k) {
+      const int shape = shape_[k];
+      stride_[k] = size;
+      size *= shape + 1;
+      for (int pos = 0; pos < shape; ++pos) {
+        // storage position bins + 1 holds the underflow bin
+        const int c = uoflow_[k] ? (pos == bins_[k] + 1 ? 0 : pos + 1) : pos;
+        off[k].push_back((c + 1) * stride_[k]);
+      }
+    }
+    table_.assign(2 * size, 0.0);
+    // each source bin goes to its own table entry, so chunks do not overlap
+    parallel_for(s.size(), 1 << 16,
+                 [this, &s, &off](unsigned, std::size_t b, std::size_t e) {
+                   remap_range(s, off, b, e, table_.data());
+                 });
+    for (unsigned k = 0; k < dim; ++k) {
+      scan(k);
+    }
+  }
+
+  /// Value and variance summed over the bins [lo[k], hi[k]) along axis k
+  std::pair<double, double> integral(const int *lo, const int *hi) const {
+    const unsigned dim = bins_.size();
+    std::size_t base = 0;
+    std::vector<std::size_t> width(dim);
+    for (unsigned k = 0; k < dim; ++k) {
+      if (lo[k] < -uoflow_[k] || hi[k] > shape_[k] - uoflow_[k] ||
+          lo[k] > hi[k]) {
+        throw std::out_of_range("invalid index range");
+      }
+      base += (lo[k] + uoflow_[k]) * stride_[k];
+      width[k] = (hi[k] - lo[k]) * stride_[k];
+    }
+    std::pair<double, double> result(0, 0);
+    // inclusion-exclusion, corners with an odd number of lower ends subtract
+    for (unsigned mask = 0; mask < (1u << dim); ++mask) {
+      std::size_t i = base;
+      bool negative = false;
+      for (unsigned k = 0; k < dim; ++k) {
+        if (mask & (1u << k)) {
+          i += width[k];
+        } else {
+          negative = !negative;
+        }
+      }
+      const double *x = table_.data() + 2 * i;
+      result.first += negative ? -x[0] : x[0];
+      result.second += negative ? -x[1] : x[1];
+    }
+    return result;
+  }
+
+private:
+  // inclusive prefix sum along axis k, lines are independent
+  void scan(unsigned k) {
+    const std::size_t n = shape_[k] + 1;
+    const std::size_t step = 2 * stride_[k], block = n * step;
+    const std::size_t nblocks = table_.size() / block;
+    double *data = table_.data();
+    auto lines = [data, n, step, block](std::size_t o, std::size_t begin,
+                                        std::size_t end) {
+      double *x = data + o * block;
+      for (std::size_t j = 1; j < n; ++j) {
+        double *cur = x + j * step;
+        const double *prev = cur - step;
+        for (std::size_t i = begin; i < end; ++i) {
+          cur[i] += prev[i];
+        }
+      }
+    };
+    if (nblocks > 1) {
+      parallel_for(nblocks, std::max<std::size_t>(1, (1 << 16) / block),
+                   [&lines, step](unsigned, std::size_t b, std::size_t e) {
+                     for (std::size_t o = b; o < e; ++o) {
+                       lines(o, 0, step);
+                     }
+                   });
+    } else {
+      parallel_for(step, std::max<std::size_t>(1, (1 << 16) / n),
+                   [&lines](unsigned, std::size_t b, std::size_t e) {
+                     lines(0, b, e);
+                   });
+    }
+  }
+
+  std::vector<int> bins_, shape_, uoflow_;
+  std::vector<std::size_t> stride_;
+  std::vector<double> table_;
+};
+
+} // namespace detail
+} // namespace histogram
+} // namespace boost
+
+#endif
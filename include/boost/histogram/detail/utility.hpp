@@ -9,11 +9,44 @@
 
 #include <ostream>
 #include <boost/call_traits.hpp>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
 
 namespace boost {
 namespace histogram {
 namespace detail {
 
+// hint to the cache to load the line at p, which is about to be written
+inline void prefetch(const void *p) noexcept {
+#if defined(__GNUC__)
+  __builtin_prefetch(p, 1);
+#else
+  (void)p;
+#endif
+}
+
+/** Counts the modifications of the content of a histogram.
+ *
+ * The count belongs to one object: copies start from zero, and assigning
+ * to a histogram counts as a modification of it.
+ */
+class change_count {
+public:
+  change_count() = default;
+  change_count(const change_count &) {}
+  change_count &operator=(const change_count &) {
+    ++value_;
+    return *this;
+  }
+
+  void bump() { ++value_; }
+  std::size_t value() const { return value_; }
+
+private:
+  std::size_t value_ = 0;
+};
+
 template <typename String>
 inline void escape(std::ostream &os, const String &s) {
   os << '\'';
@@ -27,6 +60,19 @@ inline void escape(std::ostream &os, const String &s) {
   os << '\'';
 }
 
+// whether axis A bins values of type T; the visitors of dynamic axes are
+// instantiated for every axis type and leave entries of other types out
+template <typename A, typename T> struct has_index {
+  template <typename> static std::false_type test(...);
+
+  template <typename C>
+  static decltype(std::declval<const C &>().index(std::declval<const T &>()),
+                  std::true_type{})
+  test(int);
+
+  static bool const value = decltype(test<A>(0))::value;
+};
+
 template <typename A, typename> struct lin {
   static inline void apply(std::size_t &out, std::size_t &stride,
                            const A &a, int j) noexcept {
@@ -35,7 +81,7 @@ template <typename A, typename> struct lin {
     const int uoflow = a.uoflow();
     // set stride to zero if 'j' is not in range,
     // this communicates the out-of-range condition to the caller
-    stride *= (j >= -uoflow) & (j < (a.bins() + uoflow));
+    stride *= (j >= -uoflow) & (j < (a.shape() - uoflow));
     j += (j < 0) * (a.bins() + 2); // wrap around if in < 0
     out += j * stride;
 #pragma GCC diagnostic ignored "-Wstrict-overflow"
@@ -58,6 +104,19 @@ template <typename A, typename T> struct xlin {
   }
 };
 
+// like xlin, but also records the storage position j along the axis
+template <typename A, typename T> struct xlin_pos {
+  static inline void apply(std::size_t &out, std::size_t &stride, int &pos,
+                           const A &a,
+                           typename call_traits<T>::param_type x) noexcept {
+    int j = a.index(x);
+    j += (j < 0) * (a.bins() + 2); // wrap around if j < 0
+    pos = j;
+    out += j * stride;
+    stride *= (j < a.shape()) * a.shape(); // stride == 0 indicates out-of-range
+  }
+};
+
 } // namespace detail
 } // namespace histogram
 } // namespace boost
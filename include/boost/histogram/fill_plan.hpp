@@ -0,0 +1,203 @@
+// Copyright 2015-2017 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef _BOOST_HISTOGRAM_FILL_PLAN_HPP_
+#define _BOOST_HISTOGRAM_FILL_PLAN_HPP_
+
+#include <boost/histogram/detail/meta.hpp>
+#include <boost/histogram/detail/regular_grid.hpp>
+#include <boost/histogram/detail/utility.hpp>
+#include <boost/variant.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace boost {
+namespace histogram {
+
+namespace detail {
+// storage position of x along the axis and the axis shape
+template <typename Value> struct pos_visitor : public static_visitor<void> {
+  const Value &x;
+  int &pos;
+  int &shape;
+  pos_visitor(const Value &v, int &p, int &s) : x(v), pos(p), shape(s) {}
+  template <typename A> void operator()(const A &a) const {
+    apply(a, std::integral_constant<bool, has_index<A, Value>::value>());
+  }
+  template <typename A> void apply(const A &a, std::true_type) const {
+    int j = a.index(x);
+    pos = j + (j < 0) * (a.bins() + 2);
+    shape = a.shape();
+  }
+  // the axis does not bin values of this type
+  template <typename A> void apply(const A &a, std::false_type) const {
+    pos = shape = a.shape();
+  }
+};
+} // namespace detail
+
+/** Fills many dynamic histograms from the same records.
+ *
+ * Each histogram is added with the column of the record that each of its
+ * axes reads. Axes which are equal and read the same column share one bin
+ * index computation, which is done once per entry; the histograms then
+ * only combine the shared indices into storage positions.
+ *
+ * The histograms are referenced, not copied. They must outlive the plan
+ * and must not be assigned to while they are in it. Growable axes are not
+ * shared, and histograms with marginals are filled with their own fill.
+ */
+template <typename Histogram> class fill_plan {
+public:
+  /// Adds h, axis k reads column columns[k] of each record
+  void add(Histogram &h, std::initializer_list<unsigned> columns) {
+    add(h, columns.begin(), columns.end());
+  }
+
+  /// Adds h, axis k reads column *(begin + k) of each record
+  template <typename Iterator, typename = detail::is_iterator<Iterator>>
+  void add(Histogram &h, Iterator begin, Iterator end) {
+    member m;
+    m.h = &h;
+    m.columns.assign(begin, end);
+    if (m.columns.size() != h.dim()) {
+      throw std::logic_error(
+          "number of columns does not match histogram dimension");
+    }
+    for (unsigned k = 0; k < h.dim(); ++k) {
+      const auto &a = h.axes_[k];
+      const bool growth = apply_visitor(detail::growth_visitor(), a);
+      m.growth |= growth;
+      m.slots.push_back(find_slot(a, m.columns[k], growth));
+    }
+    members_.push_back(std::move(m));
+    pos_.resize(slots_.size());
+    shape_.resize(slots_.size());
+  }
+
+  /// Number of histograms in the plan
+  std::size_t size() const { return members_.size(); }
+
+  /// Number of distinct bin index computations per entry
+  std::size_t slots() const { return slots_.size(); }
+
+  /// Fills all histograms with one record, column c is *(begin + c)
+  template <typename Iterator, typename = detail::is_iterator<Iterator>>
+  void fill(Iterator begin) {
+    fill_impl([begin](unsigned c) { return *std::next(begin, c); });
+  }
+
+  /** Fills all histograms with n records, given column by column.
+   *
+   * *(columns + c) is an iterator over the n values of column c.
+   */
+  template <typename ColumnIterator>
+  void fill_n(std::size_t n, ColumnIterator columns) {
+    using iterator = typename std::iterator_traits<ColumnIterator>::value_type;
+    unsigned ncol = 0;
+    for (const auto &m : members_) {
+      for (const auto c : m.columns) {
+        ncol = std::max(ncol, c + 1);
+      }
+    }
+    std::vector<iterator> record;
+    for (unsigned c = 0; c < ncol; ++c) {
+      record.push_back(*std::next(columns, c));
+    }
+    for (; n > 0; --n) {
+      fill_impl([&record](unsigned c) { return *record[c]; });
+      for (auto &it : record) {
+        ++it;
+      }
+    }
+  }
+
+private:
+  using axis_type = typename Histogram::axis_type;
+
+  struct slot {
+    const axis_type *axis;
+    unsigned column;
+    bool shared;
+  };
+
+  struct member {
+    Histogram *h;
+    std::vector<unsigned> columns;
+    std::vector<unsigned> slots;
+    bool growth = false;
+  };
+
+  std::vector<slot> slots_;
+  std::vector<member> members_;
+  std::vector<int> pos_, shape_;
+
+  unsigned find_slot(const axis_type &a, unsigned column, bool growth) {
+    if (!growth) {
+      for (unsigned s = 0; s < slots_.size(); ++s) {
+        if (slots_[s].shared && slots_[s].column == column &&
+            *slots_[s].axis == a) {
+          return s;
+        }
+      }
+    }
+    slots_.push_back(slot{&a, column, !growth});
+    return slots_.size() - 1;
+  }
+
+  // get(c) returns the value of column c of the record
+  template <typename Get> void fill_impl(Get get) {
+    using value_type = decltype(get(0));
+    for (unsigned s = 0; s < slots_.size(); ++s) {
+      const value_type x = get(slots_[s].column);
+      apply_visitor(detail::pos_visitor<value_type>(x, pos_[s], shape_[s]),
+                    *slots_[s].axis);
+    }
+    for (auto &m : members_) {
+      scatter(m, get);
+    }
+  }
+
+  template <typename Get> void scatter(member &m, Get &get) {
+    Histogram &h = *m.h;
+    if (!h.marginals_.empty()) {
+      fill_one(m, get);
+      return;
+    }
+    // stride becomes zero if the entry is outside of an axis, like in xlin
+    std::size_t idx = 0, stride = 1;
+    for (const auto s : m.slots) {
+      idx += pos_[s] * stride;
+      stride *= (pos_[s] < shape_[s]) * shape_[s];
+    }
+    if (stride) {
+      h.storage_.increase(idx);
+      h.changes_.bump();
+    } else if (m.growth) {
+      fill_one(m, get);
+    }
+  }
+
+  // fills the values of the columns of m through the fill of the histogram
+  template <typename Get> void fill_one(member &m, Get &get) {
+    std::vector<decltype(get(0))> values;
+    values.reserve(m.columns.size());
+    for (const auto c : m.columns) {
+      values.push_back(get(c));
+    }
+    m.h->fill(values.begin(), values.end());
+  }
+};
+
+} // namespace histogram
+} // namespace boost
+
+#endif
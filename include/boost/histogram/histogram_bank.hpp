@@ -0,0 +1,194 @@
+// Copyright 2015-2017 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef _BOOST_HISTOGRAM_HISTOGRAM_BANK_HPP_
+#define _BOOST_HISTOGRAM_HISTOGRAM_BANK_HPP_
+
+#include <boost/assert.hpp>
+#include <boost/histogram/axis.hpp>
+#include <boost/histogram/detail/meta.hpp>
+#include <boost/histogram/detail/multi_index.hpp>
+#include <boost/histogram/detail/remap.hpp>
+#include <boost/histogram/histogram_fwd.hpp>
+#include <boost/histogram/histogram_impl_dynamic.hpp>
+#include <boost/mpl/vector.hpp>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+namespace boost {
+namespace histogram {
+
+/** Many histograms with the same axes, one per channel.
+ *
+ * The axes are stored once and the bins of all channels in one storage,
+ * channel after channel, so channel c occupies the field_count() bins
+ * starting at c * field_count(). Internally, the channel is an integer
+ * axis without under-/overflow bins after the other axes. Entries with a
+ * channel outside of [0, channels()) are dropped, like values outside of
+ * an axis without overflow bin.
+ */
+template <class Axes = default_axes, class Storage = adaptive_storage<>>
+class histogram_bank {
+  using bank_axes =
+      typename detail::combine<Axes, mpl::vector<integer_axis>>::type;
+
+public:
+  /// Type of the histogram of a single channel
+  using histogram_type = histogram<Dynamic, bank_axes, Storage>;
+  using axis_type = typename histogram_type::axis_type;
+  using value_type = typename Storage::value_type;
+
+  /// Read-only access to the bins of one channel, without a copy
+  class channel_view {
+  public:
+    template <typename... Indices> value_type value(Indices... indices) const {
+      return bank_.h_.value(indices..., channel_);
+    }
+
+    template <typename... Indices>
+    value_type variance(Indices... indices) const {
+      return bank_.h_.variance(indices..., channel_);
+    }
+
+    /// Sum of all counts of the channel
+    double sum() const {
+      double result = 0.0;
+      const std::size_t n = bank_.field_count(), begin = channel_ * n;
+      for (std::size_t i = begin; i < begin + n; ++i) {
+        result += bank_.h_.storage_.value(i);
+      }
+      return result;
+    }
+
+  private:
+    channel_view(const histogram_bank &b, unsigned c) : bank_(b), channel_(c) {}
+    const histogram_bank &bank_;
+    unsigned channel_;
+    friend class histogram_bank;
+  };
+
+  histogram_bank() = default;
+
+  template <typename... Axes1>
+  explicit histogram_bank(unsigned channels, const Axes1 &... axes)
+      : h_(axes..., channel_axis(channels)) {}
+
+  template <typename Iterator, typename = detail::is_iterator<Iterator>>
+  histogram_bank(unsigned channels, Iterator axes_begin, Iterator axes_end)
+      : h_(with_channel_axis(channels, axes_begin, axes_end)) {}
+
+  bool operator==(const histogram_bank &rhs) const { return h_ == rhs.h_; }
+  bool operator!=(const histogram_bank &rhs) const { return !(h_ == rhs.h_); }
+
+  /// Adds the channels of rhs to the channels of this bank
+  histogram_bank &operator+=(const histogram_bank &rhs) {
+    h_ += rhs.h_;
+    return *this;
+  }
+
+  template <typename... Values> void fill(unsigned channel, Values... values) {
+    h_.fill(values..., channel);
+  }
+
+  template <typename... Values>
+  void wfill(unsigned channel, value_type w, Values... values) {
+    h_.wfill(w, values..., channel);
+  }
+
+  /** Fills n entries, the channels are read from \a channels and the values
+   * for axis k from iterator k of \a columns.
+   */
+  template <typename ChannelIterator, typename... Iterators>
+  void fill_n(std::size_t n, ChannelIterator channels, Iterators... columns) {
+    BOOST_ASSERT_MSG(sizeof...(columns) == dim(),
+                     "number of arguments does not match histogram dimension");
+    using swallow = int[];
+    for (; n > 0; --n) {
+      h_.fill(*columns..., static_cast<unsigned>(*channels));
+      ++channels;
+      (void)swallow{0, (++columns, 0)...};
+    }
+  }
+
+  /// Number of channels
+  unsigned channels() const {
+    return h_.dim() ? apply_visitor(detail::bins(), h_.axis(dim())) : 0;
+  }
+
+  /// Number of axes of each histogram, without the channel
+  unsigned dim() const { return h_.dim() ? h_.dim() - 1 : 0; }
+
+  /// Number of bins of each channel (including underflow/overflow)
+  std::size_t field_count() const {
+    return channels() ? h_.storage_.size() / channels() : 0;
+  }
+
+  /// Total number of bins of all channels
+  std::size_t size() const { return h_.size(); }
+
+  /// Return axis \a i
+  const axis_type &axis(unsigned i = 0) const {
+    if (i >= dim()) {
+      throw std::out_of_range("axis index out of range");
+    }
+    return h_.axis(i);
+  }
+
+  /// View on the bins of channel \a c
+  channel_view view(unsigned c) const {
+    check_channel(c);
+    return channel_view(*this, c);
+  }
+
+  /// Returns a copy of channel \a c as a separate histogram
+  histogram_type channel(unsigned c) const {
+    check_channel(c);
+    histogram_type result(h_.axes_.begin(), h_.axes_.end() - 1);
+    const std::size_t n = field_count(), begin = c * n;
+    detail::storage_for_each(
+        h_.storage_, begin, begin + n,
+        [&result, begin](std::size_t i, double value, double variance) {
+          if (value != 0 || variance != 0) {
+            detail::storage_add(result.storage_, i - begin, value, variance);
+          }
+        });
+    return result;
+  }
+
+private:
+  histogram_type h_;
+
+  static integer_axis channel_axis(unsigned channels) {
+    if (channels == 0) {
+      throw std::logic_error("at least one channel required");
+    }
+    return integer_axis(0, channels - 1, "channel", false);
+  }
+
+  template <typename Iterator>
+  static histogram_type with_channel_axis(unsigned channels, Iterator begin,
+                                          Iterator end) {
+    std::vector<axis_type> axes(begin, end);
+    axes.push_back(channel_axis(channels));
+    return histogram_type(axes.begin(), axes.end());
+  }
+
+  void check_channel(unsigned c) const {
+    if (c >= channels()) {
+      throw std::out_of_range("channel out of range");
+    }
+  }
+
+  template <class Archive, class A, class S>
+  friend void serialize(Archive &, histogram_bank<A, S> &, unsigned);
+};
+
+} // namespace histogram
+} // namespace boost
+
+#endif
@@ -8,6 +8,8 @@
 #define _BOOST_HISTOGRAM_HISTOGRAM_FWD_HPP_
 
 #include <boost/histogram/storage/adaptive_storage.hpp>
+#include <cstddef>
+#include <utility>
 
 namespace boost {
 namespace histogram {
@@ -17,6 +19,25 @@ enum type {
   Dynamic,
 };
 
+/// How fill_n applies the increments of a block of entries to the storage
+enum class fill_mode {
+  direct,     ///< in the order of the entries
+  prefetched, ///< in order, with the bins of later entries prefetched
+  bucketed,   ///< grouped by bin ranges, for storages beyond the cache
+};
+
+/// Several weights of one entry, for storages with a sum per weight
+struct weight_span {
+  const double *data;
+  std::size_t size;
+
+  weight_span(const double *d, std::size_t n) : data(d), size(n) {}
+
+  template <typename Container,
+            typename = decltype(std::declval<const Container &>().data())>
+  weight_span(const Container &c) : data(c.data()), size(c.size()) {}
+};
+
 template <type, class Axes, class Storage = adaptive_storage<>> class histogram;
 
 } // namespace histogram
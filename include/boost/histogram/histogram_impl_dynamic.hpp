@@ -11,8 +11,15 @@
 #include <boost/assert.hpp>
 #include <boost/config.hpp>
 #include <boost/histogram/axis.hpp>
+#include <boost/histogram/bin_iterator.hpp>
 #include <boost/histogram/detail/axis_visitor.hpp>
+#include <boost/histogram/detail/grow.hpp>
+#include <boost/histogram/detail/marginal_set.hpp>
 #include <boost/histogram/detail/meta.hpp>
+#include <boost/histogram/detail/rebin.hpp>
+#include <boost/histogram/detail/regular_grid.hpp>
+#include <boost/histogram/detail/remap.hpp>
+#include <boost/histogram/detail/slice.hpp>
 #include <boost/histogram/detail/utility.hpp>
 #include <boost/histogram/histogram_fwd.hpp>
 #include <boost/mpl/empty.hpp>
@@ -45,6 +52,7 @@ public:
   template <typename... Axes1>
   explicit histogram(const Axes1 &... axes) : axes_({axis_type(axes)...}) {
     storage_ = Storage(field_count());
+    update_growth();
   }
 
   template <typename Iterator, typename = detail::is_iterator<Iterator>>
@@ -52,6 +60,7 @@ public:
       : axes_(std::distance(axes_begin, axes_end)) {
     std::copy(axes_begin, axes_end, axes_.begin());
     storage_ = Storage(field_count());
+    update_growth();
   }
 
   template <type D, typename A, typename S>
@@ -59,6 +68,7 @@ public:
       : storage_(rhs.storage_)
   {
     detail::axes_assign(axes_, rhs.axes_);
+    update_growth();
   }
 
   template <type D, typename A, typename S>
@@ -66,19 +76,27 @@ public:
     if (static_cast<const void *>(this) != static_cast<const void *>(&rhs)) {
       detail::axes_assign(axes_, rhs.axes_);
       storage_ = rhs.storage_;
+      marginals_ = detail::marginal_set<Storage>();
+      changes_.bump();
+      update_growth();
     }
     return *this;
   }
 
   template <typename S>
   explicit histogram(histogram<Dynamic, Axes, S> &&rhs)
-      : axes_(std::move(rhs.axes_)), storage_(std::move(rhs.storage_)) {}
+      : axes_(std::move(rhs.axes_)), storage_(std::move(rhs.storage_)) {
+    update_growth();
+  }
 
   template <typename S>
   histogram &operator=(histogram<Dynamic, Axes, S> &&rhs) {
     if (static_cast<const void *>(this) != static_cast<const void *>(&rhs)) {
       axes_ = std::move(rhs.axes_);
       storage_ = std::move(rhs.storage_);
+      marginals_ = detail::marginal_set<Storage>();
+      changes_.bump();
+      update_growth();
     }
     return *this;
   }
@@ -99,49 +117,93 @@ public:
       throw std::logic_error("axes of histograms differ");
     }
     storage_ += rhs.storage_;
+    changes_.bump();
+    if (!marginals_.empty()) {
+      marginals_.rebuild(storage_, shapes());
+    }
     return *this;
   }
 
-  template <typename... Values> void fill(Values... values) noexcept {
+  template <typename... Values> void fill(Values... values) {
     BOOST_ASSERT_MSG(sizeof...(values) == dim(),
                      "number of arguments does not match histogram dimension");
-    const auto p =
-        apply_lin<detail::xlin, Values...>(size_pair(0, 1), values...);
-    if (p.second) {
-      storage_.increase(p.first);
-    }
+    fill_impl([](Storage &s, std::size_t i) { s.increase(i); }, values...);
   }
 
   template <typename Iterator, typename = detail::is_iterator<Iterator>>
-  void fill(Iterator begin, Iterator end) noexcept {
+  void fill(Iterator begin, Iterator end) {
     BOOST_ASSERT_MSG(std::distance(begin, end) == dim(),
                      "number of arguments does not match histogram dimension");
-    const auto p = apply_lin_iter<detail::xlin>(size_pair(0, 1), begin);
-    if (p.second) {
-      storage_.increase(p.first);
-    }
+    fill_iter_impl([](Storage &s, std::size_t i) { s.increase(i); }, begin);
   }
 
-  template <typename... Values> void wfill(value_type w, Values... values) noexcept {
+  template <typename... Values> void wfill(value_type w, Values... values) {
     BOOST_ASSERT_MSG(sizeof...(values) == dim(),
                      "number of arguments does not match histogram dimension");
-    const auto p =
-        apply_lin<detail::xlin, Values...>(size_pair(0, 1), values...);
-    if (p.second) {
-      storage_.increase(p.first, w);
-    }
+    fill_impl([w](Storage &s, std::size_t i) { s.increase(i, w); }, values...);
   }
 
   template <typename Iterator, typename = detail::is_iterator<Iterator>>
-  void wfill(value_type w, Iterator begin, Iterator end) noexcept {
+  void wfill(value_type w, Iterator begin, Iterator end) {
     BOOST_ASSERT_MSG(std::distance(begin, end) == dim(),
                      "number of arguments does not match histogram dimension");
-    const auto p = apply_lin_iter<detail::xlin>(size_pair(0, 1), begin);
-    if (p.second) {
-      storage_.increase(p.first, w);
+    fill_iter_impl([w](Storage &s, std::size_t i) { s.increase(i, w); },
+                   begin);
+  }
+
+  /** Fills n entries, skipping those for which *mask is false. The values
+   * are read row by row from \a values, dim() values per entry.
+   *
+   * The mask zeroes the stride of the storage position like a value outside
+   * of an axis does, so masked entries need no filtered copy of the input
+   * and no branch of their own.
+   */
+  template <typename MaskIterator, typename Iterator>
+  void masked_fill_n(std::size_t n, MaskIterator mask, Iterator values) {
+    for (; n > 0; --n, ++mask, std::advance(values, dim())) {
+      fill_iter_impl([](Storage &s, std::size_t i) { s.increase(i); }, values,
+                     *mask);
     }
   }
 
+  /// Like masked_fill_n, with the weights read from \a weights
+  template <typename MaskIterator, typename WeightIterator, typename Iterator>
+  void masked_wfill_n(std::size_t n, MaskIterator mask, WeightIterator weights,
+                      Iterator values) {
+    for (; n > 0; --n, ++mask, ++weights, std::advance(values, dim())) {
+      const value_type w = *weights;
+      fill_iter_impl([w](Storage &s, std::size_t i) { s.increase(i, w); },
+                     values, *mask);
+    }
+  }
+
+  /** Fills one entry with several weights, for storages with a sum per
+   * weight. The bin index is computed once for all weights.
+   */
+  template <typename... Values>
+  void wfill(const weight_span &w, Values... values) {
+    BOOST_ASSERT_MSG(sizeof...(values) == dim(),
+                     "number of arguments does not match histogram dimension");
+    fill_impl([&w](Storage &s, std::size_t i) { s.increase(i, w); },
+              values...);
+  }
+
+  /// Fills the sample y into the bin of the values, for profile storages
+  template <typename... Values> void sfill(value_type y, Values... values) {
+    wsfill(1, y, values...);
+  }
+
+  /// Fills the sample y with weight w into the bin of the values
+  template <typename... Values>
+  void wsfill(value_type w, value_type y, Values... values) {
+    static_assert(detail::has_sample<Storage>::value,
+                  "Storage lacks sample support");
+    BOOST_ASSERT_MSG(sizeof...(values) == dim(),
+                     "number of arguments does not match histogram dimension");
+    fill_impl([w, y](Storage &s, std::size_t i) { s.sample(i, y, w); },
+              values...);
+  }
+
   template <typename... Indices> value_type value(Indices... indices) const {
     BOOST_ASSERT_MSG(sizeof...(indices) == dim(),
                      "number of arguments does not match histogram dimension");
@@ -193,13 +255,23 @@ public:
   /// Number of axes (dimensions) of histogram
   unsigned dim() const noexcept { return axes_.size(); }
 
-  /// Total number of bins in the histogram (including underflow/overflow)
-  std::size_t size() const noexcept { return storage_.size(); }
+  /// Total number of bins in the histogram (including underflow/overflow),
+  /// without the empty bins that a growing category_axis reserves
+  std::size_t size() const noexcept {
+    if (axes_.empty()) {
+      return 0;
+    }
+    detail::extent_count ec;
+    for (const auto &a : axes_) {
+      apply_visitor(ec, a);
+    }
+    return ec.value;
+  }
 
   /// Sum of all counts in the histogram
   double sum() const noexcept {
     double result = 0.0;
-    for (std::size_t i = 0, n = size(); i < n; ++i) {
+    for (std::size_t i = 0, n = storage_.size(); i < n; ++i) {
       result += storage_.value(i);
     }
     return result;
@@ -224,9 +296,193 @@ public:
     }
   }
 
+  /// Apply unary functor to each bin, passing an indexed_bin
+  template <typename Unary> void for_each_bin(Unary &&unary) const {
+    detail::multi_index mi;
+    for_each_axis(mi);
+    detail::for_each_bin(storage_, mi, unary);
+  }
+
+  /// Returns a histogram over the axes \a indices, summed over all other axes
+  template <typename... Indices> histogram project(Indices... indices) const {
+    const std::vector<unsigned> idx = {static_cast<unsigned>(indices)...};
+    return project(idx.begin(), idx.end());
+  }
+
+  /// Returns a histogram over the axes with indices in [begin, end)
+  template <typename Iterator, typename = detail::is_iterator<Iterator>>
+  histogram project(Iterator begin, Iterator end) const {
+    const std::vector<unsigned> keep(begin, end);
+    const auto maps = detail::project_remap(shapes(), keep);
+    axes_type axes;
+    for (const auto k : keep) {
+      axes.push_back(axes_[k]);
+    }
+    histogram result(axes.begin(), axes.end());
+    detail::remap(storage_, maps, result.storage_);
+    return result;
+  }
+
+  /** Returns a histogram with every \a factor adjacent bins of axis \a i
+   * merged into one.
+   *
+   * Bins left over at the upper end of the axis are added to the overflow
+   * bin, or dropped if the axis has none. Merged bins of an integer_axis
+   * become a regular_axis.
+   */
+  histogram rebin(unsigned i, unsigned factor) const {
+    if (i >= dim()) {
+      throw std::out_of_range("axis index out of range");
+    }
+    const auto maps = detail::rebin_remap(
+        shapes(), i, apply_visitor(detail::bins(), axes_[i]), factor);
+    const detail::rebin_axis_fn fn{factor};
+    axes_type axes(axes_);
+    axes[i] = apply_visitor(
+        detail::convert_axis<axis_type, detail::rebin_axis_fn>(fn),
+        axes_[i]);
+    histogram result(axes.begin(), axes.end());
+    detail::remap(storage_, maps, result.storage_);
+    return result;
+  }
+
+  /** Returns a histogram in which axis \a i only has the bins [begin, end).
+   *
+   * The bins that are cut off are added to the underflow and overflow bins,
+   * or dropped if the axis has none. A slice of a circular_axis becomes a
+   * regular_axis without underflow and overflow bins.
+   */
+  histogram slice(unsigned i, int begin, int end) const {
+    if (i >= dim()) {
+      throw std::out_of_range("axis index out of range");
+    }
+    const auto &a = axes_[i];
+    const int bins = apply_visitor(detail::bins(), a);
+    detail::check_slice(bins, begin, end);
+    const detail::slice_axis_fn fn{begin, end};
+    axes_type axes(axes_);
+    axes[i] = apply_visitor(
+        detail::convert_axis<axis_type, detail::slice_axis_fn>(fn), a);
+    histogram result(axes.begin(), axes.end());
+    const auto maps = detail::slice_remap(
+        shapes(), result.shapes(), i, bins, begin, end,
+        apply_visitor(detail::uoflow(), a),
+        apply_visitor(detail::overflow_visitor(), a));
+    detail::remap(storage_, maps, result.storage_);
+    return result;
+  }
+
+  /// Keeps the projection onto the axes \a indices up to date in every fill
+  template <typename... Indices> void add_marginal(Indices... indices) {
+    const std::vector<unsigned> idx = {static_cast<unsigned>(indices)...};
+    add_marginal(idx.begin(), idx.end());
+  }
+
+  /// Keeps the projection onto the axes in [begin, end) up to date
+  template <typename Iterator, typename = detail::is_iterator<Iterator>>
+  void add_marginal(Iterator begin, Iterator end) {
+    marginals_.add(storage_, shapes(), std::vector<unsigned>(begin, end));
+  }
+
+  /// Returns the projection onto the axes \a indices, registered with
+  /// add_marginal, without a pass over the storage
+  template <typename... Indices> histogram marginal(Indices... indices) const {
+    const std::vector<unsigned> idx = {static_cast<unsigned>(indices)...};
+    return marginal(idx.begin(), idx.end());
+  }
+
+  /// Returns the projection onto the axes in [begin, end)
+  template <typename Iterator, typename = detail::is_iterator<Iterator>>
+  histogram marginal(Iterator begin, Iterator end) const {
+    const std::vector<unsigned> keep(begin, end);
+    const Storage *s = marginals_.find(keep);
+    if (!s) {
+      throw std::logic_error("marginal was not added");
+    }
+    axes_type axes;
+    for (const auto k : keep) {
+      axes.push_back(axes_[k]);
+    }
+    histogram result(axes.begin(), axes.end());
+    result.storage_ = *s;
+    return result;
+  }
+
+  /// Sum of weight k in the bin, for storages with a sum per weight
+  template <typename... Indices>
+  value_type wvalue(unsigned k, Indices... indices) const {
+    static_assert(detail::has_multi_weight<Storage>::value,
+                  "Storage lacks multiple weights");
+    BOOST_ASSERT_MSG(sizeof...(indices) == dim(),
+                     "number of arguments does not match histogram dimension");
+    const auto p =
+        apply_lin<detail::lin, Indices...>(size_pair(0, 1), indices...);
+    if (p.second == 0) {
+      throw std::out_of_range("invalid index");
+    }
+    return storage_.value(p.first, k);
+  }
+
+  /// Variance of the sum of weight k in the bin
+  template <typename... Indices>
+  value_type wvariance(unsigned k, Indices... indices) const {
+    static_assert(detail::has_multi_weight<Storage>::value,
+                  "Storage lacks multiple weights");
+    static_assert(detail::has_variance<Storage>::value,
+                  "Storage lacks variance support");
+    BOOST_ASSERT_MSG(sizeof...(indices) == dim(),
+                     "number of arguments does not match histogram dimension");
+    const auto p =
+        apply_lin<detail::lin, Indices...>(size_pair(0, 1), indices...);
+    if (p.second == 0) {
+      throw std::out_of_range("invalid index");
+    }
+    return storage_.variance(p.first, k);
+  }
+
+  /// Mean of the samples in the bin, for profile storages
+  template <typename... Indices> value_type mean(Indices... indices) const {
+    static_assert(detail::has_sample<Storage>::value,
+                  "Storage lacks sample support");
+    BOOST_ASSERT_MSG(sizeof...(indices) == dim(),
+                     "number of arguments does not match histogram dimension");
+    const auto p =
+        apply_lin<detail::lin, Indices...>(size_pair(0, 1), indices...);
+    if (p.second == 0) {
+      throw std::out_of_range("invalid index");
+    }
+    return storage_.mean(p.first);
+  }
+
+  /// Variance of the samples in the bin, for profile storages
+  template <typename... Indices>
+  value_type sample_variance(Indices... indices) const {
+    static_assert(detail::has_sample<Storage>::value,
+                  "Storage lacks sample support");
+    BOOST_ASSERT_MSG(sizeof...(indices) == dim(),
+                     "number of arguments does not match histogram dimension");
+    const auto p =
+        apply_lin<detail::lin, Indices...>(size_pair(0, 1), indices...);
+    if (p.second == 0) {
+      throw std::out_of_range("invalid index");
+    }
+    return storage_.sample_variance(p.first);
+  }
+
 private:
   axes_type axes_;
   Storage storage_;
+  detail::marginal_set<Storage> marginals_;
+  bool can_grow_ = false;
+  detail::change_count changes_;
+
+  // out-of-range fills only try to grow if an axis can
+  void update_growth() {
+    can_grow_ = false;
+    for (const auto &a : axes_) {
+      can_grow_ |= apply_visitor(detail::growth_visitor(), a);
+    }
+  }
 
   std::size_t field_count() const {
     detail::field_count fc;
@@ -236,15 +492,39 @@ private:
     return fc.value;
   }
 
+  std::vector<int> shapes() const {
+    std::vector<int> result;
+    for (const auto &a : axes_) {
+      result.push_back(apply_visitor(detail::shape(), a));
+    }
+    return result;
+  }
+
+  int count_bins() const {
+    detail::count_bins cb;
+    for_each_axis(cb);
+    return cb.value;
+  }
+
   template <template <class, class> class Lin, typename Value>
   struct lin_visitor : public static_visitor<size_pair> {
     mutable size_pair pa;
     const Value &val;
     lin_visitor(const size_pair &p, const Value &v) : pa(p), val(v) {}
     template <typename A> size_pair operator()(const A &a) const {
+      using binned =
+          std::integral_constant<bool, detail::has_index<A, Value>::value>;
+      return apply(a, binned());
+    }
+    template <typename A> size_pair apply(const A &a, std::true_type) const {
       Lin<A, Value>::apply(pa.first, pa.second, a, val);
       return pa;
     }
+    // the axis does not bin values of this type, the entry is out of range
+    template <typename A> size_pair apply(const A &, std::false_type) const {
+      pa.second = 0;
+      return pa;
+    }
   };
 
   template <template <class, class> class Lin, typename First, typename... Rest>
@@ -269,9 +549,150 @@ private:
     return p;
   }
 
+  /** Applies update(storage, i) to the bin i of the values and to the bins
+   * of the marginals, growing the axes if the values are outside of them.
+   */
+  template <typename Update, typename... Values>
+  void fill_impl(const Update &update, const Values &... values) {
+    changes_.bump();
+    if (!marginals_.empty()) {
+      const auto p = apply_lin_pos(size_pair(0, 1), marginals_.pos(), values...);
+      if (p.second) {
+        update(storage_, p.first);
+        marginals_.update(update);
+      } else if (can_grow_ && grow(values...)) {
+        fill_impl(update, values...);
+      }
+      return;
+    }
+    const auto p =
+        apply_lin<detail::xlin, Values...>(size_pair(0, 1), values...);
+    if (p.second) {
+      update(storage_, p.first);
+    } else if (can_grow_ && grow(values...)) {
+      fill_impl(update, values...);
+    }
+  }
+
+  // like fill_impl with the values read from iter, nothing happens if !keep
+  template <typename Update, typename Iterator>
+  void fill_iter_impl(const Update &update, Iterator iter, bool keep = true) {
+    changes_.bump();
+    if (!marginals_.empty()) {
+      const auto p =
+          apply_lin_iter_pos(size_pair(0, keep), marginals_.pos(), iter);
+      if (p.second) {
+        update(storage_, p.first);
+        marginals_.update(update);
+      } else if (keep && can_grow_ && grow_iter(iter)) {
+        fill_iter_impl(update, iter);
+      }
+      return;
+    }
+    const auto p = apply_lin_iter<detail::xlin>(size_pair(0, keep), iter);
+    if (p.second) {
+      update(storage_, p.first);
+    } else if (keep && can_grow_ && grow_iter(iter)) {
+      fill_iter_impl(update, iter);
+    }
+  }
+
+  /// Extends growable axes to include the values, relocating the storage
+  template <typename... Values> bool grow(const Values &... values) {
+    const auto old = shapes();
+    const int old_bins = count_bins();
+    std::vector<int> below;
+    below.reserve(dim());
+    grow_impl(below, values...);
+    return relocate(old, old_bins, below);
+  }
+
+  template <typename First, typename... Rest>
+  void grow_impl(std::vector<int> &below, const First &x,
+                 const Rest &... rest) {
+    below.push_back(apply_visitor(detail::grow_visitor<First>(x),
+                                  axes_[below.size()]));
+    grow_impl(below, rest...);
+  }
+
+  void grow_impl(std::vector<int> &) {}
+
+  template <typename Iterator> bool grow_iter(Iterator iter) {
+    using value_type = typename std::iterator_traits<Iterator>::value_type;
+    const auto old = shapes();
+    const int old_bins = count_bins();
+    std::vector<int> below;
+    below.reserve(dim());
+    for (auto &a : axes_) {
+      const value_type x = *iter++;
+      below.push_back(apply_visitor(detail::grow_visitor<value_type>(x), a));
+    }
+    return relocate(old, old_bins, below);
+  }
+
+  // moves the content into a storage for the current axes, if any grew
+  bool relocate(const std::vector<int> &old, int old_bins,
+                const std::vector<int> &below) {
+    const auto now = shapes();
+    if (now == old) {
+      return count_bins() != old_bins;
+    }
+    Storage s(field_count());
+    detail::remap(storage_, detail::grow_remap(old, now, below), s);
+    storage_ = std::move(s);
+    changes_.bump();
+    if (!marginals_.empty()) {
+      marginals_.rebuild(storage_, now);
+    }
+    return true;
+  }
+
+  template <typename Value> struct pos_visitor : public static_visitor<void> {
+    size_pair &pa;
+    int &pos;
+    const Value &val;
+    pos_visitor(size_pair &p, int &j, const Value &v) : pa(p), pos(j), val(v) {}
+    template <typename A> void operator()(const A &a) const {
+      using binned =
+          std::integral_constant<bool, detail::has_index<A, Value>::value>;
+      apply(a, binned());
+    }
+    template <typename A> void apply(const A &a, std::true_type) const {
+      detail::xlin_pos<A, Value>::apply(pa.first, pa.second, pos, a, val);
+    }
+    // the axis does not bin values of this type, the entry is out of range
+    template <typename A> void apply(const A &a, std::false_type) const {
+      pos = a.shape();
+      pa.second = 0;
+    }
+  };
+
+  template <typename First, typename... Rest>
+  size_pair apply_lin_pos(size_pair &&p, int *pos, const First &first,
+                          const Rest &... rest) const {
+    const unsigned k = dim() - 1 - sizeof...(Rest);
+    apply_visitor(pos_visitor<First>(p, pos[k], first), axes_[k]);
+    return apply_lin_pos(std::move(p), pos, rest...);
+  }
+
+  size_pair apply_lin_pos(size_pair &&p, int *) const { return p; }
+
+  template <typename Iterator>
+  size_pair apply_lin_iter_pos(size_pair &&p, int *pos, Iterator iter) const {
+    for (const auto &a : axes_) {
+      apply_visitor(pos_visitor<decltype(*iter)>(p, *pos++, *iter), a);
+      ++iter;
+    }
+    return p;
+  }
+
   friend struct storage_access;
 
   template <type D, typename A, typename S> friend class histogram;
+  template <typename H> friend class bin_iterator;
+  friend class summed_area_table;
+  template <typename A, typename S> friend class histogram_bank;
+  template <typename H> friend class fill_plan;
 
   template <typename Archiv, typename A, typename S>
   friend void serialize(Archiv &, histogram<Dynamic, A, S> &, unsigned);
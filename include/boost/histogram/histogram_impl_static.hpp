@@ -22,12 +22,25 @@
 #include <boost/fusion/sequence/comparison.hpp>
 #include <boost/histogram/histogram_fwd.hpp>
 #include <boost/histogram/axis.hpp>
+#include <boost/histogram/bin_iterator.hpp>
 #include <boost/histogram/detail/axis_visitor.hpp>
+#include <boost/histogram/detail/grow.hpp>
+#include <boost/histogram/detail/marginal_set.hpp>
 #include <boost/histogram/detail/meta.hpp>
+#include <boost/histogram/detail/rebin.hpp>
+#include <boost/histogram/detail/regular_grid.hpp>
+#include <boost/histogram/detail/remap.hpp>
+#include <boost/histogram/detail/scatter.hpp>
+#include <boost/histogram/detail/slice.hpp>
 #include <boost/histogram/detail/utility.hpp>
 #include <boost/mpl/empty.hpp>
 #include <boost/mpl/vector.hpp>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
 #include <type_traits>
+#include <vector>
 
 namespace boost {
 namespace histogram {
@@ -43,6 +56,25 @@ public:
 
 private:
   using axes_type = typename fusion::result_of::as_vector<Axes>::type;
+  template <unsigned... N>
+  using projection_type = histogram<
+      Static,
+      mpl::vector<typename fusion::result_of::value_at_c<axes_type, N>::type...>,
+      Storage>;
+  template <unsigned N>
+  using rebin_type = histogram<
+      Static,
+      typename detail::replace_at<
+          Axes, N, detail::rebinned_axis<typename fusion::result_of::value_at_c<
+                       axes_type, N>::type>>::type,
+      Storage>;
+  template <unsigned N>
+  using slice_type = histogram<
+      Static,
+      typename detail::replace_at<
+          Axes, N, detail::sliced_axis<typename fusion::result_of::value_at_c<
+                       axes_type, N>::type>>::type,
+      Storage>;
 
 public:
   histogram() = default;
@@ -50,6 +82,7 @@ public:
   template <typename... Axes1>
   explicit histogram(const Axes1 &... axes) : axes_(axes...) {
     storage_ = Storage(field_count());
+    update_growth();
   }
 
   histogram(const histogram &rhs) = default;
@@ -62,6 +95,7 @@ public:
       : storage_(rhs.storage_)
   {
     detail::axes_assign(axes_, rhs.axes_);
+    update_growth();
   }
 
   template <type D, typename A, typename S>
@@ -69,6 +103,9 @@ public:
     if (static_cast<const void *>(this) != static_cast<const void *>(&rhs)) {
       detail::axes_assign(axes_, rhs.axes_);
       storage_ = rhs.storage_;
+      marginals_ = detail::marginal_set<Storage>();
+      changes_.bump();
+      update_growth();
     }
     return *this;
   }
@@ -89,26 +126,173 @@ public:
       throw std::logic_error("axes of histograms differ");
     }
     storage_ += rhs.storage_;
+    changes_.bump();
+    if (!marginals_.empty()) {
+      marginals_.rebuild(storage_, shapes());
+    }
     return *this;
   }
 
   template <typename... Values> void fill(Values... values) {
     static_assert(sizeof...(values) == axes_size::value,
                   "number of arguments does not match histogram dimension");
-    const auto p =
-        apply_lin<detail::xlin, Values...>(size_pair(0, 1), values...);
-    if (p.second) {
-      storage_.increase(p.first);
-    }
+    fill_impl([](Storage &s, std::size_t i) { s.increase(i); }, values...);
   }
 
   template <typename... Values> void wfill(value_type w, Values... values) {
     static_assert(sizeof...(values) == axes_size::value,
                   "number of arguments does not match histogram dimension");
-    const auto p =
-        apply_lin<detail::xlin, Values...>(size_pair(0, 1), values...);
-    if (p.second) {
-      storage_.increase(p.first, w);
+    fill_impl([w](Storage &s, std::size_t i) { s.increase(i, w); }, values...);
+  }
+
+  /** Fills one entry with several weights, for storages with a sum per
+   * weight. The bin index is computed once for all weights.
+   */
+  template <typename... Values>
+  void wfill(const weight_span &w, Values... values) {
+    static_assert(sizeof...(values) == axes_size::value,
+                  "number of arguments does not match histogram dimension");
+    fill_impl([&w](Storage &s, std::size_t i) { s.increase(i, w); },
+              values...);
+  }
+
+  /** Fills n entries like fill_n(n, columns...), skipping those for which
+   * *mask is false.
+   *
+   * The mask is combined with the range check of the storage position, so
+   * masked entries cost the same as entries outside of an axis and need no
+   * filtered copy of the columns.
+   */
+  template <typename MaskIterator, typename... Iterators>
+  void masked_fill_n(std::size_t n, MaskIterator mask, Iterators... columns) {
+    static_assert(sizeof...(columns) == axes_size::value,
+                  "number of arguments does not match histogram dimension");
+    using regular = std::integral_constant<bool, detail::all_regular<Axes>::value>;
+    if (can_grow_ || !marginals_.empty()) {
+      using swallow = int[];
+      for (; n > 0; --n, ++mask) {
+        if (*mask) {
+          fill(*columns...);
+        }
+        (void)swallow{0, (++columns, 0)...};
+      }
+      return;
+    }
+    changes_.bump();
+    std::size_t pos[detail::grid_block];
+    int ok[detail::grid_block];
+    while (n > 0) {
+      const std::size_t m = n < detail::grid_block ? n : detail::grid_block;
+      fill_positions(regular(), m, pos, ok, columns...);
+      for (std::size_t i = 0; i < m; ++i, ++mask) {
+        ok[i] &= static_cast<bool>(*mask);
+      }
+      detail::direct_increase(storage_, pos, ok, m);
+      n -= m;
+    }
+  }
+
+  /// Fills the sample y into the bin of the values, for profile storages
+  template <typename... Values> void sfill(value_type y, Values... values) {
+    wsfill(1, y, values...);
+  }
+
+  /// Fills the sample y with weight w into the bin of the values
+  template <typename... Values>
+  void wsfill(value_type w, value_type y, Values... values) {
+    static_assert(detail::has_sample<Storage>::value,
+                  "Storage lacks sample support");
+    static_assert(sizeof...(values) == axes_size::value,
+                  "number of arguments does not match histogram dimension");
+    fill_impl([w, y](Storage &s, std::size_t i) { s.sample(i, y, w); },
+              values...);
+  }
+
+  /** Fills n entries, the values for axis k are read from iterator k.
+   *
+   * If all axes are regular_axis, the entries are processed in blocks:
+   * the bin indices along each axis are computed in a loop over the block
+   * without branches, and the storage position with a single range check.
+   */
+  template <typename... Iterators>
+  void fill_n(std::size_t n, Iterators... columns) {
+    fill_n(fill_mode::direct, n, columns...);
+  }
+
+  /** Like fill_n(n, columns...), with the increments applied as in mode.
+   *
+   * For storages much larger than the cache, fill_mode::prefetched and
+   * fill_mode::bucketed first compute the storage positions of a block of
+   * entries and then apply the increments, so that the cache misses of
+   * several entries overlap or turn into hits.
+   */
+  template <typename... Iterators>
+  void fill_n(fill_mode mode, std::size_t n, Iterators... columns) {
+    static_assert(sizeof...(columns) == axes_size::value,
+                  "number of arguments does not match histogram dimension");
+    using regular = std::integral_constant<bool, detail::all_regular<Axes>::value>;
+    if (can_grow_ || !marginals_.empty() ||
+        (mode == fill_mode::direct && !regular::value)) {
+      using swallow = int[];
+      for (; n > 0; --n) {
+        fill(*columns...);
+        (void)swallow{0, (++columns, 0)...};
+      }
+      return;
+    }
+    changes_.bump();
+    const std::size_t block =
+        mode == fill_mode::direct ? detail::grid_block : 1 << 16;
+    std::vector<std::size_t> pos(block);
+    std::vector<int> ok(block);
+    detail::bucket_scatter buckets(
+        mode == fill_mode::bucketed ? storage_.size() : 0);
+    while (n > 0) {
+      const std::size_t m = n < block ? n : block;
+      fill_positions(regular(), m, pos.data(), ok.data(), columns...);
+      switch (mode) {
+      case fill_mode::direct:
+        detail::direct_increase(storage_, pos.data(), ok.data(), m);
+        break;
+      case fill_mode::prefetched:
+        detail::prefetch_increase(storage_, pos.data(), ok.data(), m);
+        break;
+      case fill_mode::bucketed:
+        buckets.increase(storage_, pos.data(), ok.data(), m);
+        break;
+      }
+      n -= m;
+    }
+  }
+
+  /** Fills n samples read from \a samples, the values for axis k are read
+   * from iterator k, in blocks like fill_n(n, columns...).
+   */
+  template <typename SampleIterator, typename... Iterators>
+  void sfill_n(std::size_t n, SampleIterator samples, Iterators... columns) {
+    static_assert(detail::has_sample<Storage>::value,
+                  "Storage lacks sample support");
+    static_assert(sizeof...(columns) == axes_size::value,
+                  "number of arguments does not match histogram dimension");
+    using regular = std::integral_constant<bool, detail::all_regular<Axes>::value>;
+    if (can_grow_ || !marginals_.empty()) {
+      using swallow = int[];
+      for (; n > 0; --n) {
+        sfill(*samples, *columns...);
+        ++samples;
+        (void)swallow{0, (++columns, 0)...};
+      }
+      return;
+    }
+    changes_.bump();
+    std::size_t pos[detail::grid_block];
+    int ok[detail::grid_block];
+    while (n > 0) {
+      const std::size_t m = n < detail::grid_block ? n : detail::grid_block;
+      fill_positions(regular(), m, pos, ok, columns...);
+      storage_.sample_n(m, pos, ok, samples);
+      std::advance(samples, m);
+      n -= m;
     }
   }
 
@@ -139,13 +323,18 @@ public:
   /// Number of axes (dimensions) of histogram
   constexpr unsigned dim() const { return axes_size::value; }
 
-  /// Total number of bins in the histogram (including underflow/overflow)
-  std::size_t size() const { return storage_.size(); }
+  /// Total number of bins in the histogram (including underflow/overflow),
+  /// without the empty bins that a growing category_axis reserves
+  std::size_t size() const {
+    detail::extent_count ec;
+    fusion::for_each(axes_, std::ref(ec));
+    return ec.value;
+  }
 
   /// Sum of all counts in the histogram
   double sum() const {
     double result = 0.0;
-    for (std::size_t i = 0, n = size(); i < n; ++i) {
+    for (std::size_t i = 0, n = storage_.size(); i < n; ++i) {
       result += storage_.value(i);
     }
     return result;
@@ -161,19 +350,174 @@ public:
 
   /// Apply unary functor/function to each axis
   template <typename Unary> void for_each_axis(Unary &unary) const {
-    fusion::for_each(axes_, unary);
+    fusion::for_each(axes_, std::ref(unary));
+  }
+
+  /// Apply unary functor to each bin, passing an indexed_bin
+  template <typename Unary> void for_each_bin(Unary &&unary) const {
+    detail::multi_index mi;
+    for_each_axis(mi);
+    detail::for_each_bin(storage_, mi, unary);
+  }
+
+  /// Returns a histogram over the axes \a N..., summed over all other axes
+  template <unsigned... N> projection_type<N...> project() const {
+    const auto maps = detail::project_remap(shapes(), {N...});
+    projection_type<N...> result(fusion::at_c<N>(axes_)...);
+    detail::remap(storage_, maps, result.storage_);
+    return result;
+  }
+
+  /** Returns a histogram with every \a factor adjacent bins of axis \a N
+   * merged into one.
+   *
+   * Bins left over at the upper end of the axis are added to the overflow
+   * bin, or dropped if the axis has none. Merged bins of an integer_axis
+   * become a regular_axis.
+   */
+  template <unsigned N> rebin_type<N> rebin(unsigned factor) const {
+    const auto maps = detail::rebin_remap(
+        shapes(), N, fusion::at_c<N>(axes_).bins(), factor);
+    rebin_type<N> result;
+    detail::copy_axes_with<N>(result.axes_, axes_,
+                              detail::rebin_axis_fn{factor});
+    result.storage_ = Storage(result.field_count());
+    result.update_growth();
+    detail::remap(storage_, maps, result.storage_);
+    return result;
+  }
+
+  /** Returns a histogram in which axis \a N only has the bins [begin, end).
+   *
+   * The bins that are cut off are added to the underflow and overflow bins,
+   * or dropped if the axis has none. A slice of a circular_axis becomes a
+   * regular_axis without underflow and overflow bins.
+   */
+  template <unsigned N> slice_type<N> slice(int begin, int end) const {
+    const auto &a = fusion::at_c<N>(axes_);
+    detail::check_slice(a.bins(), begin, end);
+    slice_type<N> result;
+    detail::copy_axes_with<N>(result.axes_, axes_,
+                              detail::slice_axis_fn{begin, end});
+    result.storage_ = Storage(result.field_count());
+    result.update_growth();
+    const auto maps =
+        detail::slice_remap(shapes(), result.shapes(), N, a.bins(), begin, end,
+                            a.uoflow(), detail::has_overflow(a));
+    detail::remap(storage_, maps, result.storage_);
+    return result;
+  }
+
+  /// Keeps the projection onto the axes \a N... up to date in every fill
+  template <unsigned... N> void add_marginal() {
+    marginals_.add(storage_, shapes(), {N...});
+  }
+
+  /// Returns the projection onto the axes \a N..., registered with
+  /// add_marginal, without a pass over the storage
+  template <unsigned... N> projection_type<N...> marginal() const {
+    const Storage *s = marginals_.find({N...});
+    if (!s) {
+      throw std::logic_error("marginal was not added");
+    }
+    projection_type<N...> result(fusion::at_c<N>(axes_)...);
+    result.storage_ = *s;
+    return result;
+  }
+
+  /// Sum of weight k in the bin, for storages with a sum per weight
+  template <typename... Indices>
+  value_type wvalue(unsigned k, Indices... indices) const {
+    static_assert(detail::has_multi_weight<Storage>::value,
+                  "Storage lacks multiple weights");
+    static_assert(sizeof...(indices) == axes_size::value,
+                  "number of arguments does not match histogram dimension");
+    const auto p =
+        apply_lin<detail::lin, Indices...>(size_pair(0, 1), indices...);
+    if (p.second == 0) {
+      throw std::out_of_range("invalid index");
+    }
+    return storage_.value(p.first, k);
+  }
+
+  /// Variance of the sum of weight k in the bin
+  template <typename... Indices>
+  value_type wvariance(unsigned k, Indices... indices) const {
+    static_assert(detail::has_multi_weight<Storage>::value,
+                  "Storage lacks multiple weights");
+    static_assert(detail::has_variance<Storage>::value,
+                  "Storage lacks variance support");
+    static_assert(sizeof...(indices) == axes_size::value,
+                  "number of arguments does not match histogram dimension");
+    const auto p =
+        apply_lin<detail::lin, Indices...>(size_pair(0, 1), indices...);
+    if (p.second == 0) {
+      throw std::out_of_range("invalid index");
+    }
+    return storage_.variance(p.first, k);
+  }
+
+  /// Mean of the samples in the bin, for profile storages
+  template <typename... Indices> value_type mean(Indices... indices) const {
+    static_assert(detail::has_sample<Storage>::value,
+                  "Storage lacks sample support");
+    static_assert(sizeof...(indices) == axes_size::value,
+                  "number of arguments does not match histogram dimension");
+    const auto p =
+        apply_lin<detail::lin, Indices...>(size_pair(0, 1), indices...);
+    if (p.second == 0) {
+      throw std::out_of_range("invalid index");
+    }
+    return storage_.mean(p.first);
+  }
+
+  /// Variance of the samples in the bin, for profile storages
+  template <typename... Indices>
+  value_type sample_variance(Indices... indices) const {
+    static_assert(detail::has_sample<Storage>::value,
+                  "Storage lacks sample support");
+    static_assert(sizeof...(indices) == axes_size::value,
+                  "number of arguments does not match histogram dimension");
+    const auto p =
+        apply_lin<detail::lin, Indices...>(size_pair(0, 1), indices...);
+    if (p.second == 0) {
+      throw std::out_of_range("invalid index");
+    }
+    return storage_.sample_variance(p.first);
   }
 
 private:
   axes_type axes_;
   Storage storage_;
+  detail::marginal_set<Storage> marginals_;
+  bool can_grow_ = false;
+  detail::change_count changes_;
+
+  // out-of-range fills only try to grow if an axis can
+  void update_growth() {
+    detail::any_growth g;
+    fusion::for_each(axes_, std::ref(g));
+    can_grow_ = g.value;
+  }
 
   std::size_t field_count() const {
     detail::field_count fc;
-    fusion::for_each(axes_, fc);
+    fusion::for_each(axes_, std::ref(fc));
     return fc.value;
   }
 
+  std::vector<int> shapes() const {
+    detail::collect_shapes cs;
+    fusion::for_each(axes_, std::ref(cs));
+    return cs.value;
+  }
+
+  int count_bins() const {
+    detail::count_bins cb;
+    fusion::for_each(axes_, std::ref(cb));
+    return cb.value;
+  }
+
   template <template <class, class> class Lin, typename First, typename... Rest>
   size_pair apply_lin(size_pair &&p, const First &x,
                       const Rest &... rest) const {
@@ -191,7 +535,111 @@ private:
     return p;
   }
 
+  // storage positions of the next m entries, ok[i] == 0 if out of range
+  template <typename... Iterators>
+  void fill_positions(std::true_type, std::size_t m, std::size_t *pos, int *ok,
+                      Iterators &... columns) const {
+    for (std::size_t i = 0; i < m; i += detail::grid_block) {
+      const unsigned k =
+          m - i < detail::grid_block ? m - i : detail::grid_block;
+      std::fill(pos + i, pos + i + k, 0);
+      std::fill(ok + i, ok + i + k, 1);
+      std::size_t stride = 1;
+      grid_index<0>(k, stride, pos + i, ok + i, columns...);
+    }
+  }
+
+  template <typename... Iterators>
+  void fill_positions(std::false_type, std::size_t m, std::size_t *pos,
+                      int *ok, Iterators &... columns) const {
+    using swallow = int[];
+    for (std::size_t i = 0; i < m; ++i) {
+      const auto p = apply_lin<detail::xlin>(size_pair(0, 1), *columns...);
+      pos[i] = p.first;
+      ok[i] = p.second != 0;
+      (void)swallow{0, (++columns, 0)...};
+    }
+  }
+
+  template <unsigned K, typename First, typename... Rest>
+  void grid_index(unsigned m, std::size_t &stride, std::size_t *pos, int *ok,
+                  First &first, Rest &... rest) const {
+    detail::grid_index(fusion::at_c<K>(axes_), first, m, stride, pos, ok);
+    grid_index<K + 1>(m, stride, pos, ok, rest...);
+  }
+
+  template <unsigned K>
+  void grid_index(unsigned, std::size_t &, std::size_t *, int *) const {}
+
+  /** Applies update(storage, i) to the bin i of the values and to the bins
+   * of the marginals, growing the axes if the values are outside of them.
+   */
+  template <typename Update, typename... Values>
+  void fill_impl(const Update &update, const Values &... values) {
+    changes_.bump();
+    if (!marginals_.empty()) {
+      const auto p = apply_lin_pos(size_pair(0, 1), marginals_.pos(), values...);
+      if (p.second) {
+        update(storage_, p.first);
+        marginals_.update(update);
+      } else if (can_grow_ && grow(values...)) {
+        fill_impl(update, values...);
+      }
+      return;
+    }
+    const auto p =
+        apply_lin<detail::xlin, Values...>(size_pair(0, 1), values...);
+    if (p.second) {
+      update(storage_, p.first);
+    } else if (can_grow_ && grow(values...)) {
+      fill_impl(update, values...);
+    }
+  }
+
+  /// Extends growable axes to include the values, relocating the storage
+  template <typename... Values> bool grow(const Values &... values) {
+    const auto old = shapes();
+    const int old_bins = count_bins();
+    std::vector<int> below(axes_size::value, 0);
+    grow_impl(below.data(), values...);
+    const auto now = shapes();
+    if (now == old) {
+      return count_bins() != old_bins;
+    }
+    Storage s(field_count());
+    detail::remap(storage_, detail::grow_remap(old, now, below), s);
+    storage_ = std::move(s);
+    changes_.bump();
+    if (!marginals_.empty()) {
+      marginals_.rebuild(storage_, now);
+    }
+    return true;
+  }
+
+  template <typename First, typename... Rest>
+  void grow_impl(int *below, const First &x, const Rest &... rest) {
+    constexpr unsigned k = axes_size::value - 1 - sizeof...(Rest);
+    below[k] = detail::grow_axis(fusion::at_c<k>(axes_), x);
+    grow_impl(below, rest...);
+  }
+
+  void grow_impl(int *) {}
+
+  template <typename First, typename... Rest>
+  size_pair apply_lin_pos(size_pair &&p, int *pos, const First &x,
+                          const Rest &... rest) const {
+    constexpr unsigned k = axes_size::value - 1 - sizeof...(Rest);
+    detail::xlin_pos<typename fusion::result_of::value_at_c<axes_type, k>::type,
+                     First>::apply(p.first, p.second, pos[k],
+                                   fusion::at_c<k>(axes_), x);
+    return apply_lin_pos(std::move(p), pos, rest...);
+  }
+
+  size_pair apply_lin_pos(size_pair &&p, int *) const { return p; }
+
   template <type D, typename A, typename S> friend class histogram;
+  template <typename H> friend class bin_iterator;
+  friend class summed_area_table;
 
   template <class Archive, class S, class A>
   friend void serialize(Archive &, histogram<Static, S, A> &, unsigned);
@@ -12,11 +12,16 @@
 #include <boost/histogram/detail/utility.hpp>
 #include <boost/histogram/detail/weight.hpp>
 #include <boost/histogram/histogram.hpp>
+#include <boost/histogram/histogram_bank.hpp>
 #include <boost/histogram/storage/adaptive_storage.hpp>
 #include <boost/histogram/storage/container_storage.hpp>
+#include <boost/histogram/storage/multi_weight_storage.hpp>
+#include <boost/histogram/storage/profile_storage.hpp>
+#include <boost/mpl/int.hpp>
 #include <boost/serialization/array.hpp>
 #include <boost/serialization/variant.hpp>
 #include <boost/serialization/vector.hpp>
+#include <boost/serialization/version.hpp>
 
 /** \file boost/histogram/serialization.hpp
  *  \brief Defines the serialization functions, to use with boost.serialize.
@@ -34,6 +39,15 @@ inline void serialize(Archive &ar, weight &wt, unsigned /* version */) {
   ar &wt.w2;
 }
 
+template <class Archive>
+inline void serialize(Archive &ar, profile_bin &b, unsigned /* version */) {
+  ar &b.w;
+  ar &b.w2;
+  ar &b.sw;
+  ar &b.mean;
+  ar &b.m2;
+}
+
 template <typename Archive> struct serialize_helper {
   Archive &ar_;
   explicit serialize_helper(Archive &ar) : ar_(ar) {}
@@ -48,6 +62,18 @@ inline void serialize(Archive &ar, container_storage<Container> &store,
   ar &store.c_;
 }
 
+template <class Archive, unsigned K, bool Squares>
+inline void serialize(Archive &ar, multi_weight_storage<K, Squares> &store,
+                      unsigned /* version */) {
+  ar &store.data_;
+}
+
+template <class Archive>
+inline void serialize(Archive &ar, profile_storage &store,
+                      unsigned /* version */) {
+  ar &store.bins_;
+}
+
 template <template <class> class Allocator>
 template <class Archive>
 void adaptive_storage<Allocator>::serialize(Archive &ar,
@@ -134,10 +160,63 @@ inline void serialize(Archive &ar, axis_base<true> &base,
 
 template <class Archive, typename RealType>
 inline void serialize(Archive &ar, regular_axis<RealType> &axis,
+                      unsigned version) {
+  ar &boost::serialization::base_object<axis_base<true>>(axis);
+  ar &axis.anchor_; // the lower edge before version 2
+  ar &axis.delta_;
+  if (version >= 1) {
+    ar &axis.growth_;
+  } else {
+    axis.growth_ = false;
+  }
+  if (version >= 2) {
+    ar &axis.offset_;
+  } else {
+    axis.offset_ = 0;
+  }
+  if (Archive::is_loading::value) {
+    axis.min_ = axis.anchor_ - axis.offset_ * axis.delta_;
+  }
+}
+
+namespace transform {
+template <class Archive>
+inline void serialize(Archive &, log &, unsigned /* version */) {}
+
+template <class Archive>
+inline void serialize(Archive &, sqrt &, unsigned /* version */) {}
+
+template <class Archive>
+inline void serialize(Archive &ar, pow &t, unsigned /* version */) {
+  ar &t.power;
+}
+} // namespace transform
+
+template <class Archive, typename Transform, typename RealType>
+inline void serialize(Archive &ar, transform_axis<Transform, RealType> &axis,
                       unsigned /* version */) {
   ar &boost::serialization::base_object<axis_base<true>>(axis);
+  ar &axis.transform_;
   ar &axis.min_;
   ar &axis.delta_;
+  RealType lo = 0, hi = 0;
+  if (Archive::is_saving::value) {
+    lo = axis[0];
+    hi = axis[axis.bins()];
+  }
+  ar &lo;
+  ar &hi;
+  if (Archive::is_loading::value) {
+    axis.build_edges(lo, hi);
+  }
+}
+
+template <class Archive, unsigned N, typename Min, typename Max, bool UOFlow,
+          typename RealType>
+inline void serialize(Archive &ar,
+                      static_regular_axis<N, Min, Max, UOFlow, RealType> &axis,
+                      unsigned /* version */) {
+  ar &axis.label_;
 }
 
 template <class Archive, typename RealType>
@@ -158,20 +237,63 @@ inline void serialize(Archive &ar, variable_axis<RealType> &axis,
   ar &boost::serialization::make_array(axis.x_.get(), axis.bins() + 1);
 }
 
+template <class Archive, typename UInt>
+inline void serialize(Archive &ar, lookup_axis<UInt> &axis,
+                      unsigned /* version */) {
+  ar &boost::serialization::base_object<axis_base<true>>(axis);
+  if (Archive::is_loading::value) {
+    axis.x_.resize(axis.bins() + 1);
+  }
+  ar &boost::serialization::make_array(axis.x_.data(), axis.bins() + 1);
+  if (Archive::is_loading::value) {
+    axis.build_table();
+  }
+}
+
 template <class Archive>
-inline void serialize(Archive &ar, integer_axis &axis, unsigned /* version */) {
+inline void serialize(Archive &ar, integer_axis &axis, unsigned version) {
   ar &boost::serialization::base_object<axis_base<true>>(axis);
   ar &axis.min_;
+  if (version >= 1) {
+    ar &axis.growth_;
+  } else {
+    axis.growth_ = false;
+  }
 }
 
 template <class Archive>
-inline void serialize(Archive &ar, category_axis &axis,
+inline void serialize(Archive &ar, shift_axis &axis, unsigned /* version */) {
+  ar &boost::serialization::base_object<axis_base<true>>(axis);
+  ar &axis.min_;
+  ar &axis.shift_;
+}
+
+template <class Archive>
+inline void serialize(Archive &ar, log_linear_axis &axis,
                       unsigned /* version */) {
+  ar &boost::serialization::base_object<axis_base<true>>(axis);
+  ar &axis.p_;
+  ar &axis.max_;
+}
+
+template <class Archive>
+inline void serialize(Archive &ar, category_axis &axis, unsigned version) {
   ar &boost::serialization::base_object<axis_base<false>>(axis);
   if (Archive::is_loading::value) {
-    axis.ptr_.reset(new std::string[axis.bins()]);
+    axis.cat_.resize(axis.bins());
+  }
+  ar &boost::serialization::make_array(axis.cat_.data(), axis.bins());
+  if (version >= 1) {
+    ar &axis.overflow_;
+    ar &axis.growth_;
+  } else {
+    axis.overflow_ = false;
+    axis.growth_ = false;
+  }
+  if (Archive::is_loading::value) {
+    axis.build_index();
+    axis.update_reserve();
   }
-  ar &boost::serialization::make_array(axis.ptr_.get(), axis.bins());
 }
 
 template <class Archive, class A, class S>
@@ -180,6 +302,12 @@ inline void serialize(Archive &ar, histogram<Static, A, S> &h,
   detail::serialize_helper<Archive> sh(ar);
   fusion::for_each(h.axes_, sh);
   ar &h.storage_;
+  if (Archive::is_loading::value) {
+    // marginals are not archived, their strides belong to the old shape
+    h.marginals_ = detail::marginal_set<S>();
+    h.changes_.bump();
+    h.update_growth();
+  }
 }
 
 template <class Archive, class A, class S>
@@ -187,9 +315,33 @@ inline void serialize(Archive &ar, histogram<Dynamic, A, S> &h,
                       unsigned /* version */) {
   ar &h.axes_;
   ar &h.storage_;
+  if (Archive::is_loading::value) {
+    // marginals are not archived, their strides belong to the old shape
+    h.marginals_ = detail::marginal_set<S>();
+    h.changes_.bump();
+    h.update_growth();
+  }
+}
+
+template <class Archive, class A, class S>
+inline void serialize(Archive &ar, histogram_bank<A, S> &b,
+                      unsigned /* version */) {
+  ar &b.h_;
 }
 
 } // namespace histogram
+
+namespace serialization {
+// version 1 adds the growth flag
+template <typename RealType>
+struct version<histogram::regular_axis<RealType>> : mpl::int_<2> {};
+} // namespace serialization
 } // namespace boost
 
+// version 1 adds the growth flag
+BOOST_CLASS_VERSION(boost::histogram::integer_axis, 1)
+
+// version 1 adds the overflow and growth flags
+BOOST_CLASS_VERSION(boost::histogram::category_axis, 1)
+
 #endif
@@ -10,10 +10,12 @@
 #include <algorithm>
 #include <boost/cstdint.hpp>
 #include <boost/histogram/detail/meta.hpp>
+#include <boost/histogram/detail/utility.hpp>
 #include <boost/histogram/detail/variance.hpp>
 #include <boost/histogram/detail/weight.hpp>
 #include <boost/multiprecision/cpp_int.hpp>
 #include <boost/variant.hpp>
+#include <cmath>
 #include <limits>
 #include <type_traits>
 
@@ -185,6 +187,25 @@ public:
     apply_visitor(wincrease_visitor(i, w, buffer_), buffer_);
   }
 
+  /// Adds a value with its variance to bin i
+  void add(std::size_t i, value_type value, value_type variance) {
+    if (value == variance && value >= 0 && value == std::floor(value)) {
+      apply_visitor(add_visitor<value_type>(i, value, buffer_), buffer_);
+    } else {
+      apply_visitor(wadd_visitor(i, value, variance, buffer_), buffer_);
+    }
+  }
+
+  /// Adds bin j of rhs to bin i, counts are added as exact integers
+  void add(std::size_t i, const adaptive_storage &rhs, std::size_t j) {
+    apply_visitor(bin_add_visitor(i, j, buffer_), rhs.buffer_);
+  }
+
+  /// Whether the sum of all counts may not be exact in a double
+  bool large_counts() const {
+    return apply_visitor(large_counts_visitor(), buffer_);
+  }
+
   value_type value(std::size_t i) const {
     return apply_visitor(value_visitor(i), buffer_);
   }
@@ -193,6 +214,17 @@ public:
     return apply_visitor(variance_visitor(i), buffer_);
   }
 
+  /// Calls f(i, value, variance) for each bin i in [begin, end)
+  template <typename F>
+  void for_each(std::size_t begin, std::size_t end, F &&f) const {
+    apply_visitor(for_each_visitor<F>(begin, end, f), buffer_);
+  }
+
+  /// Asks the cache to load bin i, ahead of an increase
+  void prefetch(std::size_t i) const {
+    apply_visitor(prefetch_visitor(i), buffer_);
+  }
+
   template <typename S> adaptive_storage &operator+=(const S &rhs) {
     for (std::size_t i = 0, n = rhs.size(); i < n; ++i)
       apply_visitor(
@@ -297,6 +329,86 @@ private:
     void operator()(array<weight> &b) const { b[idx].add_weight(w); }
   };
 
+  struct wadd_visitor : public static_visitor<void> {
+    const std::size_t &idx;
+    const value_type &w, &w2;
+    buffer_type &buffer;
+    wadd_visitor(const std::size_t &i, const value_type &v,
+                 const value_type &v2, buffer_type &b)
+        : idx(i), w(v), w2(v2), buffer(b) {}
+
+    template <typename Array> void operator()(Array &b) const {
+      array<weight> nb(b);
+      (*this)(nb);
+      buffer = std::move(nb);
+    }
+
+    void operator()(array<void> &b) const {
+      array<weight> nb(b.size);
+      (*this)(nb);
+      buffer = std::move(nb);
+    }
+
+    void operator()(array<weight> &b) const {
+      b[idx].w += w;
+      b[idx].w2 += w2;
+    }
+  };
+
+  struct bin_add_visitor : public static_visitor<void> {
+    const std::size_t &idx, &jdx;
+    buffer_type &buffer;
+    bin_add_visitor(const std::size_t &i, const std::size_t &j, buffer_type &b)
+        : idx(i), jdx(j), buffer(b) {}
+
+    template <typename Array> void operator()(const Array &b) const {
+      using T = typename Array::value_type;
+      const T x = b[jdx];
+      apply_visitor(add_visitor<T>(idx, x, buffer), buffer);
+    }
+
+    void operator()(const array<void> & /*b*/) const {}
+
+    void operator()(const array<weight> &b) const {
+      apply_visitor(wadd_visitor(idx, b[jdx].w, b[jdx].w2, buffer), buffer);
+    }
+  };
+
+  struct large_counts_visitor : public static_visitor<bool> {
+    template <typename Array> bool operator()(const Array &b) const {
+      using T = typename Array::value_type;
+      const uint64_t limit = uint64_t(1) << std::numeric_limits<double>::digits;
+      if (double(b.size) * std::numeric_limits<T>::max() < limit) {
+        return false;
+      }
+      uint64_t sum = 0;
+      for (std::size_t i = 0; i < b.size; ++i) {
+        if (b[i] >= limit - sum) {
+          return true;
+        }
+        sum += b[i];
+      }
+      return false;
+    }
+
+    bool operator()(const array<void> & /*b*/) const { return false; }
+
+    bool operator()(const array<mp_int> & /*b*/) const { return true; }
+
+    bool operator()(const array<weight> & /*b*/) const { return false; }
+  };
+
+  struct prefetch_visitor : public static_visitor<void> {
+    const std::size_t &idx;
+    prefetch_visitor(const std::size_t &i) : idx(i) {}
+
+    template <typename Array> void operator()(const Array &b) const {
+      detail::prefetch(&b[idx]);
+    }
+
+    void operator()(const array<void> & /*b*/) const {}
+  };
+
   struct value_visitor : public static_visitor<value_type> {
     const std::size_t &idx;
     value_visitor(const std::size_t &i) : idx(i) {}
@@ -331,6 +443,32 @@ private:
     }
   };
 
+  template <typename F> struct for_each_visitor : public static_visitor<void> {
+    const std::size_t begin, end;
+    F &f;
+    for_each_visitor(std::size_t b, std::size_t e, F &fun)
+        : begin(b), end(e), f(fun) {}
+
+    template <typename Array> void operator()(const Array &b) const {
+      for (std::size_t i = begin; i < end; ++i) {
+        const auto x = static_cast<value_type>(b[i]);
+        f(i, x, x);
+      }
+    }
+
+    void operator()(const array<void> & /*b*/) const {
+      for (std::size_t i = begin; i < end; ++i) {
+        f(i, value_type(0), value_type(0));
+      }
+    }
+
+    void operator()(const array<weight> &b) const {
+      for (std::size_t i = begin; i < end; ++i) {
+        f(i, static_cast<value_type>(b[i].w), static_cast<value_type>(b[i].w2));
+      }
+    }
+  };
+
   template <typename Value> struct add_visitor : public static_visitor<void> {
     const std::size_t &idx;
     const Value &value;
@@ -342,7 +480,7 @@ private:
       using T = typename Array::value_type;
       T &x = b[idx];
       if (static_cast<T>(std::numeric_limits<T>::max() - x) > value) {
-        x += value;
+        x += static_cast<T>(value);
       } else {
         buffer = array<next<T>>(b);
         (*this)(get<array<next<T>>>(buffer));
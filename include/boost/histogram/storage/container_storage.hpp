@@ -9,6 +9,7 @@
 
 #include <algorithm>
 #include <boost/histogram/detail/meta.hpp>
+#include <boost/histogram/detail/utility.hpp>
 #include <cstddef>
 
 namespace boost {
@@ -62,7 +63,19 @@ public:
   std::size_t size() const { return container_.size(); }
   void increase(std::size_t i) { ++(container_[i]); }
   void increase(std::size_t i, value_type w) { container_[i] += w; }
+  void add(std::size_t i, double value, double /*variance*/) {
+    container_[i] += value;
+  }
   value_type value(std::size_t i) const { return container_[i]; }
+  void prefetch(std::size_t i) const { detail::prefetch(&container_[i]); }
+
+  /// Calls f(i, value, variance) for each bin i in [begin, end)
+  template <typename F>
+  void for_each(std::size_t begin, std::size_t end, F &&f) const {
+    for (std::size_t i = begin; i < end; ++i) {
+      f(i, container_[i], container_[i]);
+    }
+  }
 
   template <typename OtherStorage> void operator+=(const OtherStorage &other) {
     for (std::size_t i = 0; i < container_.size(); ++i) {
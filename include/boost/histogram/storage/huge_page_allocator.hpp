@@ -0,0 +1,182 @@
+// Copyright 2015-2017 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef _BOOST_HISTOGRAM_STORAGE_HUGE_PAGE_ALLOCATOR_HPP_
+#define _BOOST_HISTOGRAM_STORAGE_HUGE_PAGE_ALLOCATOR_HPP_
+
+#include <algorithm>
+#include <boost/assert.hpp>
+#include <boost/histogram/detail/parallel.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace boost {
+namespace histogram {
+
+/// Placement of the pages of a large buffer on NUMA systems.
+enum class numa_policy {
+  local,      ///< Default policy of the OS, pages go where they are touched.
+  interleave, ///< Pages are distributed round-robin over all allowed nodes.
+  first_touch ///< Buffer is touched in shards by one thread per core.
+};
+
+namespace detail {
+
+// transparent huge pages on x86_64 and aarch64
+constexpr std::size_t huge_page_size = std::size_t(1) << 21;
+
+/// Size of a mapping of at least bytes, a multiple of the huge page size
+constexpr std::size_t huge_page_round(std::size_t bytes) {
+  return (bytes + huge_page_size - 1) & ~(huge_page_size - 1);
+}
+
+#if defined(__linux__)
+inline void *map_huge_pages(std::size_t bytes, numa_policy policy) {
+  // over-allocate to align the buffer to the huge page boundary, then give
+  // the unaligned head and tail back to the OS; the buffer is rounded up to
+  // whole huge pages, so that the tail starts on a page boundary
+  bytes = huge_page_round(bytes);
+  const std::size_t mapped = bytes + huge_page_size;
+  void *raw = ::mmap(nullptr, mapped, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (raw == MAP_FAILED) {
+    throw std::bad_alloc();
+  }
+  const auto addr = reinterpret_cast<std::uintptr_t>(raw);
+  const auto aligned =
+      (addr + huge_page_size - 1) & ~(std::uintptr_t(huge_page_size) - 1);
+  const std::size_t head = aligned - addr, tail = mapped - head - bytes;
+  if ((head && ::munmap(raw, head) != 0) ||
+      (tail && ::munmap(reinterpret_cast<void *>(aligned + bytes), tail) != 0)) {
+    ::munmap(raw, mapped);
+    throw std::bad_alloc();
+  }
+  void *ptr = reinterpret_cast<void *>(aligned);
+
+#ifdef MADV_HUGEPAGE
+  ::madvise(ptr, bytes, MADV_HUGEPAGE); // only a hint, failure is harmless
+#endif
+
+#if defined(SYS_mbind) && defined(SYS_get_mempolicy)
+  if (policy == numa_policy::interleave) {
+    // constants from <numaif.h>, which we do not want to depend on
+    const int mpol_interleave = 3;
+    const unsigned long mpol_f_mems_allowed = 1 << 2;
+    unsigned long nodes[16] = {};
+    const unsigned long maxnode = 8 * sizeof(nodes);
+    if (::syscall(SYS_get_mempolicy, nullptr, nodes, maxnode, nullptr,
+                  mpol_f_mems_allowed) == 0) {
+      // best effort, an unsupported policy leaves the default in place
+      ::syscall(SYS_mbind, ptr, bytes, mpol_interleave, nodes, maxnode, 0);
+    }
+  }
+#endif
+
+  if (policy == numa_policy::first_touch) {
+    // each thread faults in its own shard, so that the pages are spread
+    // over the nodes on which the threads are scheduled
+    auto *p = static_cast<char *>(ptr);
+    parallel_for(bytes / huge_page_size + 1, 1,
+                 [p, bytes](unsigned, std::size_t begin, std::size_t end) {
+                   const std::size_t b = begin * huge_page_size;
+                   const std::size_t e = std::min(end * huge_page_size, bytes);
+                   if (b < e) {
+                     std::memset(p + b, 0, e - b);
+                   }
+                 });
+  }
+  return ptr;
+}
+
+/// Unmaps a buffer of map_huge_pages(bytes), returns false on failure
+inline bool unmap_huge_pages(void *ptr, std::size_t bytes) {
+  return ::munmap(ptr, huge_page_round(bytes)) == 0;
+}
+#endif
+
+} // namespace detail
+
+/** Allocator for large buffers backed by transparent huge pages.
+ *
+ * Buffers of at least one huge page are mapped directly from the OS,
+ * aligned to the huge page size and advised to be backed by huge pages,
+ * which reduces TLB misses when a large histogram is filled at random
+ * positions. The NUMA placement of the pages is controlled by the
+ * policy. Smaller buffers are taken from the free store. On platforms
+ * other than Linux, this is equivalent to std::allocator.
+ */
+template <typename T, numa_policy Policy>
+class basic_huge_page_allocator {
+public:
+  using value_type = T;
+  template <typename U> struct rebind {
+    using other = basic_huge_page_allocator<U, Policy>;
+  };
+
+  basic_huge_page_allocator() = default;
+  template <typename U>
+  basic_huge_page_allocator(const basic_huge_page_allocator<U, Policy> &) {}
+
+  T *allocate(std::size_t n) {
+    const std::size_t bytes = n * sizeof(T);
+#if defined(__linux__)
+    if (bytes >= detail::huge_page_size) {
+      return static_cast<T *>(detail::map_huge_pages(bytes, Policy));
+    }
+#endif
+    return static_cast<T *>(::operator new(bytes));
+  }
+
+  void deallocate(T *p, std::size_t n) {
+#if defined(__linux__)
+    const std::size_t bytes = n * sizeof(T);
+    if (bytes >= detail::huge_page_size) {
+      const bool ok = detail::unmap_huge_pages(p, bytes);
+      BOOST_ASSERT_MSG(ok, "munmap failed");
+      (void)ok;
+      return;
+    }
+#endif
+    (void)n;
+    ::operator delete(p);
+  }
+
+  template <typename U>
+  bool operator==(const basic_huge_page_allocator<U, Policy> &) const {
+    return true;
+  }
+  template <typename U>
+  bool operator!=(const basic_huge_page_allocator<U, Policy> &) const {
+    return false;
+  }
+};
+
+/// Huge page allocator with the default NUMA placement of the OS
+template <typename T>
+using huge_page_allocator = basic_huge_page_allocator<T, numa_policy::local>;
+
+/// Huge page allocator which interleaves pages over all NUMA nodes
+template <typename T>
+using interleaved_huge_page_allocator =
+    basic_huge_page_allocator<T, numa_policy::interleave>;
+
+/// Huge page allocator which places pages by parallel first touch
+template <typename T>
+using first_touch_huge_page_allocator =
+    basic_huge_page_allocator<T, numa_policy::first_touch>;
+
+} // namespace histogram
+} // namespace boost
+
+#endif
@@ -0,0 +1,148 @@
+// Copyright 2015-2017 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef _BOOST_HISTOGRAM_STORAGE_MULTI_WEIGHT_HPP_
+#define _BOOST_HISTOGRAM_STORAGE_MULTI_WEIGHT_HPP_
+
+#include <boost/histogram/detail/utility.hpp>
+#include <boost/histogram/histogram_fwd.hpp>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace boost {
+namespace histogram {
+
+namespace detail {
+/// The K sums of a bin of a multi_weight_storage, followed by the squares
+struct weight_block {
+  const double *data;
+};
+} // namespace detail
+
+/** Storage with K sums of weights per bin, for example one per systematic
+ * variation.
+ *
+ * A bin is a contiguous block of K sums of weights, followed by K sums of
+ * squared weights if Squares is true. Filling an entry with K weights thus
+ * computes the bin index once and adds two contiguous arrays of fixed
+ * length, which the compiler vectorizes. value(i) and variance(i) are
+ * those of the first weight. Without Squares there are no variances, like
+ * in storages without weights, and variance is not available.
+ */
+template <unsigned K, bool Squares = true> class multi_weight_storage {
+  static_assert(K > 0, "at least one weight required");
+
+public:
+  using value_type = double;
+
+  /// Number of doubles per bin
+  static constexpr std::size_t stride = Squares ? 2 * K : K;
+
+  explicit multi_weight_storage(std::size_t s) : data_(s * stride, 0.0) {}
+
+  multi_weight_storage() = default;
+  multi_weight_storage(const multi_weight_storage &) = default;
+  multi_weight_storage &operator=(const multi_weight_storage &) = default;
+  multi_weight_storage(multi_weight_storage &&) = default;
+  multi_weight_storage &operator=(multi_weight_storage &&) = default;
+
+  std::size_t size() const { return data_.size() / stride; }
+
+  /// Number of weights per entry
+  static constexpr unsigned weights() { return K; }
+
+  /// Adds one to all sums of bin i
+  void increase(std::size_t i) { increase(i, 1.0); }
+
+  /// Adds w to all sums of bin i
+  void increase(std::size_t i, value_type w) {
+    double *b = &data_[i * stride];
+    for (unsigned k = 0; k < K; ++k) {
+      b[k] += w;
+    }
+    if (Squares) {
+      for (unsigned k = 0; k < K; ++k) {
+        b[K + k] += w * w;
+      }
+    }
+  }
+
+  /// Adds weight k of w to sum k of bin i
+  void increase(std::size_t i, const weight_span &w) {
+    if (w.size != K) {
+      throw std::logic_error("number of weights does not match storage");
+    }
+    double *b = &data_[i * stride];
+    for (unsigned k = 0; k < K; ++k) {
+      b[k] += w.data[k];
+    }
+    if (Squares) {
+      for (unsigned k = 0; k < K; ++k) {
+        b[K + k] += w.data[k] * w.data[k];
+      }
+    }
+  }
+
+  /// Adds the sums of b to bin i
+  void add(std::size_t i, const detail::weight_block &b) {
+    double *x = &data_[i * stride];
+    for (unsigned k = 0; k < stride; ++k) {
+      x[k] += b.data[k];
+    }
+  }
+
+  /// Sums of bin i
+  detail::weight_block bin(std::size_t i) const {
+    return detail::weight_block{&data_[i * stride]};
+  }
+
+  value_type value(std::size_t i) const { return value(i, 0); }
+
+  template <bool S = Squares, typename = typename std::enable_if<S>::type>
+  value_type variance(std::size_t i) const {
+    return variance(i, 0);
+  }
+
+  /// Sum of weight k in bin i
+  value_type value(std::size_t i, unsigned k) const {
+    return data_[i * stride + k];
+  }
+
+  /// Sum of squares of weight k in bin i
+  template <bool S = Squares, typename = typename std::enable_if<S>::type>
+  value_type variance(std::size_t i, unsigned k) const {
+    return data_[i * stride + K + k];
+  }
+
+  void prefetch(std::size_t i) const { detail::prefetch(&data_[i * stride]); }
+
+  multi_weight_storage &operator+=(const multi_weight_storage &rhs) {
+    for (std::size_t i = 0; i < data_.size(); ++i) {
+      data_[i] += rhs.data_[i];
+    }
+    return *this;
+  }
+
+  bool operator==(const multi_weight_storage &rhs) const {
+    return data_ == rhs.data_;
+  }
+
+private:
+  std::vector<double> data_;
+
+  template <typename Archive, unsigned N, bool S>
+  friend void serialize(Archive &, multi_weight_storage<N, S> &, unsigned);
+};
+
+template <unsigned K, bool Squares>
+constexpr std::size_t multi_weight_storage<K, Squares>::stride;
+
+} // namespace histogram
+} // namespace boost
+
+#endif
@@ -0,0 +1,162 @@
+// Copyright 2015-2017 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef _BOOST_HISTOGRAM_STORAGE_PROFILE_HPP_
+#define _BOOST_HISTOGRAM_STORAGE_PROFILE_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace boost {
+namespace histogram {
+
+namespace detail {
+/** Counts and sample statistics of a bin of a profile.
+ *
+ * w and w2 are the sums of weights and squared weights of all entries. The
+ * samples keep their own sum of weights sw, their mean and the sum m2 of
+ * weighted squared deviations from the mean, which are updated as in
+ * Welford's algorithm and merged with the formula of Chan et al., so that
+ * the variance does not cancel when the samples are large compared to
+ * their spread.
+ */
+struct profile_bin {
+  double w, w2, sw, mean, m2;
+
+  /// Adds the sample y with weight v to the sample statistics
+  void sample(double y, double v) {
+    sw += v;
+    if (sw != 0) {
+      const double d = y - mean;
+      mean += d * v / sw;
+      m2 += v * d * (y - mean);
+    }
+  }
+
+  profile_bin &operator+=(const profile_bin &rhs) {
+    w += rhs.w;
+    w2 += rhs.w2;
+    if (rhs.sw != 0) {
+      const double s = sw + rhs.sw, d = rhs.mean - mean;
+      mean += d * rhs.sw / s;
+      m2 += rhs.m2 + d * d * sw * rhs.sw / s;
+      sw = s;
+    }
+    return *this;
+  }
+
+  bool operator==(const profile_bin &rhs) const {
+    return w == rhs.w && w2 == rhs.w2 && sw == rhs.sw && mean == rhs.mean &&
+           m2 == rhs.m2;
+  }
+};
+} // namespace detail
+
+/** Storage for profiles, the mean of a sample in each bin.
+ *
+ * Each bin holds the sum of weights and of squared weights of its entries,
+ * and the weight, mean and summed squared deviations of its samples, next
+ * to each other. value(i) and variance(i) are those of the sum of weights
+ * like in other storages, so that counting, merging and comparing works as
+ * usual, while mean(i) and sample_variance(i) describe the sample. Entries
+ * filled without a sample only add to the counts and leave the mean alone.
+ * Projections, rebin, slice and growing axes move whole bins, so they keep
+ * the sample.
+ */
+class profile_storage {
+public:
+  using value_type = double;
+
+  explicit profile_storage(std::size_t s) : bins_(s) {}
+
+  profile_storage() = default;
+  profile_storage(const profile_storage &) = default;
+  profile_storage &operator=(const profile_storage &) = default;
+  profile_storage(profile_storage &&) = default;
+  profile_storage &operator=(profile_storage &&) = default;
+
+  std::size_t size() const { return bins_.size(); }
+
+  void increase(std::size_t i) {
+    bins_[i].w += 1;
+    bins_[i].w2 += 1;
+  }
+
+  void increase(std::size_t i, value_type w) {
+    bins_[i].w += w;
+    bins_[i].w2 += w * w;
+  }
+
+  /// Adds a value with its variance to the counts of bin i
+  void add(std::size_t i, value_type value, value_type variance) {
+    bins_[i].w += value;
+    bins_[i].w2 += variance;
+  }
+
+  /// Merges the entries of b into bin i
+  void add(std::size_t i, const detail::profile_bin &b) { bins_[i] += b; }
+
+  /// Counts and sample statistics of bin i
+  const detail::profile_bin &bin(std::size_t i) const { return bins_[i]; }
+
+  /// Adds the sample y with weight w to bin i
+  void sample(std::size_t i, value_type y, value_type w = 1) {
+    auto &b = bins_[i];
+    b.w += w;
+    b.w2 += w * w;
+    b.sample(y, w);
+  }
+
+  /// Adds the samples *y++ to bins pos[i] for all i < n with ok[i] != 0
+  template <typename Iterator>
+  void sample_n(std::size_t n, const std::size_t *pos, const int *ok,
+                Iterator y) {
+    for (std::size_t i = 0; i < n; ++i, ++y) {
+      if (ok[i]) {
+        sample(pos[i], *y);
+      }
+    }
+  }
+
+  value_type value(std::size_t i) const { return bins_[i].w; }
+  value_type variance(std::size_t i) const { return bins_[i].w2; }
+
+  /// Weighted mean of the samples in bin i, nan if it has none
+  value_type mean(std::size_t i) const {
+    return bins_[i].sw != 0 ? bins_[i].mean
+                            : std::numeric_limits<value_type>::quiet_NaN();
+  }
+
+  /// Weighted variance of the samples in bin i, around their mean
+  value_type sample_variance(std::size_t i) const {
+    return bins_[i].m2 / bins_[i].sw;
+  }
+
+  profile_storage &operator+=(const profile_storage &rhs) {
+    for (std::size_t i = 0; i < bins_.size(); ++i) {
+      bins_[i] += rhs.bins_[i];
+    }
+    return *this;
+  }
+
+  bool operator==(const profile_storage &rhs) const {
+    return bins_.size() == rhs.bins_.size() &&
+           std::equal(bins_.begin(), bins_.end(), rhs.bins_.begin());
+  }
+
+private:
+  std::vector<detail::profile_bin> bins_;
+
+  template <typename Archive>
+  friend void serialize(Archive &, profile_storage &, unsigned);
+};
+
+} // namespace histogram
+} // namespace boost
+
+#endif
@@ -0,0 +1,105 @@
+// Copyright 2015-2017 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef _BOOST_HISTOGRAM_SUMMED_AREA_TABLE_HPP_
+#define _BOOST_HISTOGRAM_SUMMED_AREA_TABLE_HPP_
+
+#include <boost/assert.hpp>
+#include <boost/histogram/detail/meta.hpp>
+#include <boost/histogram/detail/summed_area.hpp>
+#include <boost/histogram/detail/utility.hpp>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+namespace boost {
+namespace histogram {
+
+/** Sums of values and variances over boxes of bins of a histogram.
+ *
+ * The table is built from the histogram once, in one pass over the storage
+ * and one scan per axis, and then answers every sum with 2^dim lookups.
+ * It is as large as the storage and owned by the caller; const calls on
+ * one table may run concurrently. The table remembers the histogram, which
+ * must outlive it: once the histogram was filled, added to, grown or
+ * assigned, sums throw std::logic_error until rebuild() is called.
+ */
+class summed_area_table {
+public:
+  template <typename Histogram> explicit summed_area_table(const Histogram &h) {
+    rebuild(h);
+  }
+
+  /// Builds the table again from the current content of h
+  template <typename Histogram> void rebuild(const Histogram &h) {
+    table_ = detail::summed_area();
+    h.for_each_axis(table_);
+    table_.build(h.storage_);
+    changes_ = &h.changes_;
+    built_ = changes_->value();
+  }
+
+  /// Whether the histogram is unchanged since the table was built
+  bool is_current() const { return changes_->value() == built_; }
+
+  /// Number of axes
+  unsigned dim() const { return table_.dim(); }
+
+  /** Sum of values over a box of bins, args are the indices lo... and hi...
+   *
+   * Bins with lo <= i < hi along each axis are included, where -1 and
+   * bins() denote the underflow and overflow bins.
+   */
+  template <typename... Indices> double integral(Indices... args) const {
+    BOOST_ASSERT_MSG(sizeof...(args) == 2 * dim(),
+                     "number of arguments does not match histogram dimension");
+    check_current();
+    const int idx[] = {static_cast<int>(args)...};
+    return table_.integral(idx, idx + dim()).first;
+  }
+
+  /// Sum of values over a box of bins, lo and hi point to dim() indices each
+  template <typename Iterator, typename = detail::is_iterator<Iterator>>
+  double integral(Iterator lo, Iterator hi) const {
+    check_current();
+    const std::vector<int> l(lo, lo + dim()), h(hi, hi + dim());
+    return table_.integral(l.data(), h.data()).first;
+  }
+
+  /// Sum of variances over a box of bins, see integral
+  template <typename... Indices>
+  double integral_variance(Indices... args) const {
+    BOOST_ASSERT_MSG(sizeof...(args) == 2 * dim(),
+                     "number of arguments does not match histogram dimension");
+    check_current();
+    const int idx[] = {static_cast<int>(args)...};
+    return table_.integral(idx, idx + dim()).second;
+  }
+
+  /// Sum of variances over a box of bins, see integral
+  template <typename Iterator, typename = detail::is_iterator<Iterator>>
+  double integral_variance(Iterator lo, Iterator hi) const {
+    check_current();
+    const std::vector<int> l(lo, lo + dim()), h(hi, hi + dim());
+    return table_.integral(l.data(), h.data()).second;
+  }
+
+private:
+  void check_current() const {
+    if (!is_current()) {
+      throw std::logic_error("histogram changed since the table was built");
+    }
+  }
+
+  detail::summed_area table_;
+  const detail::change_count *changes_ = nullptr;
+  std::size_t built_ = 0;
+};
+
+} // namespace histogram
+} // namespace boost
+
+#endif
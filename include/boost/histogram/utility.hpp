@@ -9,6 +9,8 @@
 
 #include <boost/histogram/detail/axis_visitor.hpp>
 #include <boost/variant/variant_fwd.hpp>
+#include <limits>
+#include <stdexcept>
 
 namespace boost {
 namespace histogram {
@@ -62,6 +64,42 @@ double center(const boost::variant<Axes...> &a, const int i) {
   return apply_visitor(detail::center(i), a);
 }
 
+/** Returns the value below which a fraction q of the entries lie.
+ *
+ * For one-dimensional histograms. The entries are assumed to be uniformly
+ * distributed inside each bin. Entries in the underflow and overflow bins
+ * count, but the result is clamped to the range of the axis. Returns NaN
+ * for an empty histogram.
+ */
+template <typename Histogram> double quantile(const Histogram &h, double q) {
+  if (h.dim() != 1) {
+    throw std::logic_error("one-dimensional histogram required");
+  }
+  if (!(0 <= q && q <= 1)) {
+    throw std::out_of_range("0 <= q <= 1 required");
+  }
+  const auto &a = h.axis();
+  const int n = bins(a), extra = detail::extent(a) - n;
+  const double total = h.sum();
+  if (total == 0) {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+  const double target = q * total;
+  double sum = 0;
+  for (int i = -(extra > 1); i < n + (extra > 0); ++i) {
+    const double v = h.value(i);
+    if (v > 0 && sum + v >= target) {
+      if (i < 0 || i == n) {
+        return left(a, i < 0 ? 0 : n);
+      }
+      const double lo = left(a, i), hi = right(a, i);
+      return lo + (hi - lo) * (target - sum) / v;
+    }
+    sum += v;
+  }
+  return left(a, n);
+}
+
 } // namespace histogram
 } // namespace boost
 
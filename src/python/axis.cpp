@@ -68,12 +68,15 @@ python::object category_axis_init(python::tuple args, python::dict kwargs) {
   }
 
   std::string label;
+  bool overflow = false;
   while (len(kwargs) > 0) {
     python::tuple kv = kwargs.popitem();
     std::string k = extract<std::string>(kv[0]);
     object v = kv[1];
     if (k == "label")
       label = extract<std::string>(v);
+    else if (k == "overflow")
+      overflow = extract<bool>(v);
     else {
       std::stringstream s;
       s << "keyword " << k << " not recognized";
@@ -86,9 +89,23 @@ python::object category_axis_init(python::tuple args, python::dict kwargs) {
   for (int i = 1, n = len(args); i < n; ++i)
     c.push_back(extract<std::string>(args[i]));
 
-  return self.attr("__init__")(category_axis(c.begin(), c.end(), label));
+  return self.attr("__init__")(
+      category_axis(c.begin(), c.end(), label, overflow));
 }
 
+template <typename T> struct axis_index {
+  static int apply(const T &t, typename T::value_type x) { return t.index(x); }
+};
+
+template <> struct axis_index<category_axis> {
+  static int apply(const category_axis &t, python::object x) {
+    python::extract<std::string> s(x);
+    if (s.check())
+      return t.index(s());
+    return t.index(python::extract<int>(x)());
+  }
+};
+
 template <typename T> int axis_len(const T &t) {
   return t.bins() + int(std::is_floating_point<typename T::value_type>::value);
 }
@@ -121,7 +138,7 @@ struct axis_suite : public python::def_visitor<axis_suite<T>> {
             python::return_value_policy<python::copy_const_reference>()),
         (void (T::*)(const std::string &)) & T::label,
         "Name or description for the axis.");
-    cl.def("index", &T::index, ":param float x: value"
+    cl.def("index", &axis_index<T>::apply, ":param float x: value"
                                "\n:returns: bin index for the passed value",
            python::args("self", "x"));
     cl.def("__len__", axis_len<T>, ":returns: number of bins for this axis",
@@ -150,11 +167,27 @@ void register_axis_types() {
                          "An axis for real-valued data and bins of equal width."
                          "\nBinning is a O(1) operation.",
                          no_init)
-      .def(init<unsigned, double, double, const std::string &, bool>(
+      .def(init<unsigned, double, double, const std::string &, bool, bool>(
           (arg("self"), arg("bin"), arg("min"), arg("max"),
-           arg("label") = std::string(), arg("uoflow") = true)))
+           arg("label") = std::string(), arg("uoflow") = true,
+           arg("growth") = false)))
+      .add_property("growth", &regular_axis<>::growth,
+                    "Whether the axis grows to include values outside of it.")
       .def(axis_suite<regular_axis<>>());
 
+  class_<regular_axis<float>>(
+      "regular_axis_float32",
+      "Like regular_axis, but with edges in single precision,"
+      "\nfor float32 input.",
+      no_init)
+      .def(init<unsigned, float, float, const std::string &, bool, bool>(
+          (arg("self"), arg("bin"), arg("min"), arg("max"),
+           arg("label") = std::string(), arg("uoflow") = true,
+           arg("growth") = false)))
+      .add_property("growth", &regular_axis<float>::growth,
+                    "Whether the axis grows to include values outside of it.")
+      .def(axis_suite<regular_axis<float>>());
+
   class_<circular_axis<>>(
       "circular_axis",
       "An axis for real-valued angles."
@@ -183,20 +216,24 @@ void register_axis_types() {
                        "\nThere are no underflow/overflow bins for this axis."
                        "\nBinning is a O(1) operation.",
                        no_init)
-      .def(init<int, int, const std::string &, bool>(
+      .def(init<int, int, const std::string &, bool, bool>(
           (arg("self"), arg("min"), arg("max"), arg("label") = std::string(),
-           arg("uoflow") = true)))
+           arg("uoflow") = true, arg("growth") = false)))
+      .add_property("growth", &integer_axis::growth,
+                    "Whether the axis grows to include values outside of it.")
       .def(axis_suite<integer_axis>());
 
   class_<category_axis>("category_axis",
                         "An axis for enumerated categories. The axis stores the"
-                        "\ncategory labels, and expects that they are addressed"
-                        "\nusing an integer from 0 to n-1. There are no"
-                        "\nunderflow/overflow bins for this axis."
+                        "\ncategory labels, which are addressed by name or"
+                        "\nusing an integer from 0 to n-1. Unknown categories"
+                        "\nare counted in an overflow bin if overflow=True."
                         "\nBinning is a O(1) operation.",
                         no_init)
       .def("__init__", raw_function(category_axis_init))
       .def(init<const category_axis &>())
+      .add_property("overflow", &category_axis::overflow,
+                    "Whether unknown categories are counted in an overflow bin.")
       .def(axis_suite<category_axis>());
 }
 }
@@ -6,6 +6,7 @@
 
 #include "serialization_suite.hpp"
 #include <boost/histogram/axis.hpp>
+#include <boost/histogram/bit_iterator.hpp>
 #include <boost/histogram/histogram.hpp>
 #include <boost/histogram/histogram_ostream_operators.hpp>
 #include <boost/histogram/serialization.hpp>
@@ -35,6 +36,63 @@ using dynamic_histogram = histogram<Dynamic, default_axes, adaptive_storage<>>;
 auto array_cast = [](python::handle<>& h) {
   return python::downcast<PyArrayObject>(h.get());
 };
+
+// fills the rows of a, with weights from aw if it is not null
+template <typename T>
+void fill_rows(dynamic_histogram &self, python::handle<> &a,
+               python::handle<> *aw) {
+  const npy_intp n = PyArray_DIMS(array_cast(a))[0];
+  for (npy_intp i = 0; i < n; ++i) {
+    T *v = reinterpret_cast<T *>(PyArray_GETPTR1(array_cast(a), i));
+    if (aw) {
+      double *w = reinterpret_cast<double *>(PyArray_GETPTR1(array_cast(*aw), i));
+      self.wfill(*w, v, v + self.dim());
+    } else {
+      self.fill(v, v + self.dim());
+    }
+  }
+}
+
+// fills the rows of a for which mask is true, with weights from aw if it is
+// not null; a is C-contiguous
+template <typename T, typename MaskIterator>
+void fill_masked_rows(dynamic_histogram &self, python::handle<> &a,
+                      python::handle<> *aw, MaskIterator mask) {
+  const npy_intp n = PyArray_DIMS(array_cast(a))[0];
+  const T *v = reinterpret_cast<const T *>(PyArray_DATA(array_cast(a)));
+  if (aw) {
+    const double *w =
+        reinterpret_cast<const double *>(PyArray_DATA(array_cast(*aw)));
+    self.masked_wfill_n(n, mask, w, v);
+  } else {
+    self.masked_fill_n(n, mask, v);
+  }
+}
+
+// fills with a bool array of one entry per row, or a uint8 array of bits
+// packed as by numpy.packbits(..., bitorder='little')
+template <typename T>
+void fill_masked(dynamic_histogram &self, python::handle<> &a,
+                 python::handle<> *aw, python::object &om) {
+  const npy_intp n = PyArray_DIMS(array_cast(a))[0];
+  const bool packed =
+      PyArray_Check(om.ptr()) &&
+      PyArray_TYPE(reinterpret_cast<PyArrayObject *>(om.ptr())) == NPY_UINT8;
+  python::handle<> am(PyArray_FROM_OTF(om.ptr(), packed ? NPY_UINT8 : NPY_BOOL,
+                                       NPY_ARRAY_IN_ARRAY));
+  if (PyArray_NDIM(array_cast(am)) != 1 ||
+      PyArray_DIMS(array_cast(am))[0] != (packed ? (n + 7) / 8 : n)) {
+    PyErr_SetString(PyExc_ValueError, "mask size does not match");
+    python::throw_error_already_set();
+  }
+  const auto *m =
+      reinterpret_cast<const unsigned char *>(PyArray_DATA(array_cast(am)));
+  if (packed) {
+    fill_masked_rows<T>(self, a, aw, bit_iterator(m));
+  } else {
+    fill_masked_rows<T>(self, a, aw, reinterpret_cast<const npy_bool *>(m));
+  }
+}
 #endif
 
 struct axis_visitor : public static_visitor<python::object> {
@@ -74,6 +132,11 @@ python::object histogram_init(python::tuple args, python::dict kwargs) {
       axes.push_back(er());
       continue;
     }
+    python::extract<regular_axis<float>> erf(pa);
+    if (erf.check()) {
+      axes.push_back(erf());
+      continue;
+    }
     python::extract<circular_axis<>> ep(pa);
     if (ep.check()) {
       axes.push_back(ep());
@@ -107,21 +170,30 @@ python::object histogram_fill(python::tuple args, python::dict kwargs) {
   const unsigned nargs = python::len(args);
   dynamic_histogram &self = python::extract<dynamic_histogram &>(args[0]);
 
-  python::object ow;
+  python::object ow, om;
   if (kwargs) {
-    if (len(kwargs) > 1 || !kwargs.has_key("w")) {
-      PyErr_SetString(PyExc_RuntimeError, "only keyword w allowed");
+    const unsigned nkw = kwargs.has_key("w") + kwargs.has_key("mask");
+    if (len(kwargs) > nkw) {
+      PyErr_SetString(PyExc_RuntimeError, "only keywords w and mask allowed");
       python::throw_error_already_set();
     }
     ow = kwargs.get("w");
+    om = kwargs.get("mask");
   }
 
 #ifdef HAVE_NUMPY
   if (nargs == 2) {
     python::object o = args[1];
     if (PySequence_Check(o.ptr())) {
+      // float32 input is passed on without a conversion to double
+      const int type =
+          PyArray_Check(o.ptr()) &&
+                  PyArray_TYPE(reinterpret_cast<PyArrayObject *>(o.ptr())) ==
+                      NPY_FLOAT
+              ? NPY_FLOAT
+              : NPY_DOUBLE;
       // exception is thrown automatically if
-      python::handle<> a(PyArray_FROM_OTF(o.ptr(), NPY_DOUBLE, NPY_ARRAY_IN_ARRAY));
+      python::handle<> a(PyArray_FROM_OTF(o.ptr(), type, NPY_ARRAY_IN_ARRAY));
 
       npy_intp *dims = PyArray_DIMS(array_cast(a));
       switch (PyArray_NDIM(array_cast(a))) {
@@ -161,20 +233,33 @@ python::object histogram_fill(python::tuple args, python::dict kwargs) {
             python::throw_error_already_set();
           }
 
-          for (unsigned i = 0; i < dims[0]; ++i) {
-            double *v = reinterpret_cast<double *>(PyArray_GETPTR1(array_cast(a), i));
-            double *w = reinterpret_cast<double *>(PyArray_GETPTR1(array_cast(aw), i));
-            self.wfill(*w, v, v + self.dim());
+          if (!om.is_none()) {
+            if (type == NPY_FLOAT) {
+              fill_masked<float>(self, a, &aw, om);
+            } else {
+              fill_masked<double>(self, a, &aw, om);
+            }
+          } else if (type == NPY_FLOAT) {
+            fill_rows<float>(self, a, &aw);
+          } else {
+            fill_rows<double>(self, a, &aw);
           }
 
         } else {
           PyErr_SetString(PyExc_ValueError, "w is not a sequence");
           python::throw_error_already_set();
         }
+      } else if (!om.is_none()) {
+        if (type == NPY_FLOAT) {
+          fill_masked<float>(self, a, nullptr, om);
+        } else {
+          fill_masked<double>(self, a, nullptr, om);
+        }
       } else {
-        for (unsigned i = 0; i < dims[0]; ++i) {
-          double *v = reinterpret_cast<double *>(PyArray_GETPTR1(array_cast(a), i));
-          self.fill(v, v + self.dim());
+        if (type == NPY_FLOAT) {
+          fill_rows<float>(self, a, nullptr);
+        } else {
+          fill_rows<double>(self, a, nullptr);
         }
       }
 
@@ -197,8 +282,20 @@ python::object histogram_fill(python::tuple args, python::dict kwargs) {
   }
 
   double v[BOOST_HISTOGRAM_AXIS_LIMIT];
-  for (unsigned i = 0; i < dim; ++i)
-    v[i] = python::extract<double>(args[1 + i]);
+  for (unsigned i = 0; i < dim; ++i) {
+    python::extract<std::string> s(args[1 + i]);
+    const category_axis *c = boost::get<category_axis>(&self.axis(i));
+    if (c && s.check()) {
+      // look up the name here, the histogram is filled with bin indices
+      v[i] = c->index(s());
+    } else {
+      v[i] = python::extract<double>(args[1 + i]);
+    }
+  }
+
+  if (!om.is_none() && !python::extract<bool>(om)) {
+    return python::object();
+  }
 
   if (ow.is_none()) {
     self.fill(v, v + self.dim());
@@ -267,6 +364,30 @@ python::object histogram_variance(python::tuple args, python::dict kwargs) {
   return python::object(self.variance(idx + 0, idx + self.dim()));
 }
 
+python::object histogram_project(python::tuple args, python::dict kwargs) {
+  const dynamic_histogram &self =
+      python::extract<const dynamic_histogram &>(args[0]);
+
+  if (kwargs) {
+    PyErr_SetString(PyExc_RuntimeError, "no keyword arguments allowed");
+    python::throw_error_already_set();
+  }
+
+  std::vector<unsigned> idx;
+  for (unsigned i = 1, n = len(args); i < n; ++i)
+    idx.push_back(python::extract<unsigned>(args[i]));
+
+  try {
+    return python::object(self.project(idx.begin(), idx.end()));
+  } catch (const std::out_of_range &e) {
+    PyErr_SetString(PyExc_IndexError, e.what());
+  } catch (const std::logic_error &e) {
+    PyErr_SetString(PyExc_ValueError, e.what());
+  }
+  python::throw_error_already_set();
+  return python::object();
+}
+
 std::string histogram_repr(const dynamic_histogram &h) {
   std::ostringstream os;
   os << h;
@@ -412,7 +533,11 @@ void register_histogram() {
            "\nIf Numpy support is enabled, values may also"
            "\nbe a 2d-array of shape (m, n), where m is"
            "\nthe number of tuples, and optionally"
-           "\nanother a second 1d-array w of shape (n,).")
+           "\nanother a second 1d-array w of shape (n,)."
+           "\n"
+           "\nA mask skips the entries for which it is false,"
+           "\nfor arrays a bool array of shape (m,) or a uint8"
+           "\narray of bits packed with bitorder='little'.")
       .add_property("sum", &dynamic_histogram::sum)
       .def("value", python::raw_function(histogram_value),
            ":param int args: indices of the bin"
@@ -420,6 +545,19 @@ void register_histogram() {
       .def("variance", python::raw_function(histogram_variance),
            ":param int args: indices of the bin"
            "\n:return: variance estimate for the bin")
+      .def("project", python::raw_function(histogram_project),
+           ":param int args: indices of the axes to keep"
+           "\n:return: histogram over these axes, summed over the others")
+      .def("rebin", &dynamic_histogram::rebin,
+           ":param int axis: index of the axis"
+           "\n:param int factor: number of adjacent bins to merge"
+           "\n:return: histogram with merged bins along the axis")
+      .def("slice", &dynamic_histogram::slice,
+           ":param int axis: index of the axis"
+           "\n:param int begin: first bin to keep"
+           "\n:param int end: bin after the last bin to keep"
+           "\n:return: histogram with the other bins folded into"
+           "\nunderflow and overflow")
       .def("__repr__", histogram_repr,
            ":returns: string representation of the histogram")
       .def(python::self == python::self)
@@ -10,6 +10,7 @@
 #include <boost/histogram/serialization.hpp>
 #include <boost/histogram/storage/adaptive_storage.hpp>
 #include <boost/histogram/storage/container_storage.hpp>
+#include <boost/histogram/storage/huge_page_allocator.hpp>
 #include <limits>
 #include <sstream>
 
@@ -56,6 +57,37 @@ struct storage_access {
   }
 };
 
+template <template <class> class Allocator> void huge_page_impl() {
+  // large enough to be mapped with huge pages
+  const std::size_t n = detail::huge_page_size;
+  adaptive_storage<Allocator> a(n);
+  container_storage<std::vector<unsigned>> ref(n);
+  for (std::size_t i = 0; i < n; i += 4097) {
+    for (unsigned k = 0; k < 3; ++k) {
+      a.increase(i);
+      ref.increase(i);
+    }
+  }
+  a.increase(n - 1);
+  ref.increase(n - 1);
+  BOOST_TEST(a == ref);
+  BOOST_TEST_EQ(a.value(0), 3.0);
+  BOOST_TEST_EQ(a.value(n - 1), 1.0);
+
+  auto b = a;
+  BOOST_TEST(b == a);
+  b.increase(1, 2.0);
+  BOOST_TEST_EQ(b.value(1), 2.0);
+  BOOST_TEST_EQ(b.variance(1), 4.0);
+  BOOST_TEST_EQ(b.value(0), 3.0);
+  BOOST_TEST(!(b == a));
+
+  // small buffers are not mapped separately
+  adaptive_storage<Allocator> c(2);
+  c.increase(0);
+  BOOST_TEST_EQ(c.value(0), 1.0);
+}
+
 template <typename T> void copy_impl() {
   const auto b = prepare<T>(1);
   auto a(b);
@@ -343,6 +375,28 @@ int main() {
     }
   }
 
+  // add bins exactly
+  {
+    const auto a = storage_access::set_value(2, detail::mp_int(1) << 70);
+    BOOST_TEST(a.large_counts());
+    adaptive_storage<> b(2);
+    BOOST_TEST(!b.large_counts());
+    b.increase(0);
+    b.add(0, a, 0);
+    b.add(1, a, 1);
+    const auto ref =
+        storage_access::set_value(2, (detail::mp_int(1) << 70) + 1);
+    BOOST_TEST(b == ref);
+    BOOST_TEST(!(b == a));
+
+    adaptive_storage<> c(1), d(1);
+    c.increase(0, 2.0);
+    d.increase(0);
+    d.add(0, c, 0);
+    BOOST_TEST_EQ(d.value(0), 3.0);
+    BOOST_TEST_EQ(d.variance(0), 5.0);
+  }
+
   // convert_container_storage
   {
     convert_container_storage_impl<void>();
@@ -354,6 +408,13 @@ int main() {
     convert_container_storage_impl<detail::weight>();
   }
 
+  // huge_page_allocator
+  {
+    huge_page_impl<huge_page_allocator>();
+    huge_page_impl<interleaved_huge_page_allocator>();
+    huge_page_impl<first_touch_huge_page_allocator>();
+  }
+
   // serialization_test
   {
     serialization_impl<void>();
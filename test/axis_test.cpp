@@ -13,7 +13,10 @@
 #include <boost/math/constants/constants.hpp>
 #include <boost/variant.hpp>
 #include <boost/fusion/include/vector.hpp>
+#include <iterator>
 #include <limits>
+#include <string>
+#include <vector>
 
 #define BOOST_TEST_NOT(expr) BOOST_TEST(!(expr))
 
@@ -84,6 +87,129 @@ int main() {
     BOOST_TEST_EQ(a.index(std::numeric_limits<double>::quiet_NaN()), -1);
   }
 
+  // regular_axis batch index
+  {
+    const regular_axis<> a{30, -1.1, 2.3};
+    const regular_axis<> b{7, 1000, 1000.07};
+    const regular_axis<float> c{30, -1.1, 2.3};
+    for (const auto *ax : {&a, &b}) {
+      std::vector<float> xf;
+      for (int i = -1; i <= ax->bins() + 1; ++i) {
+        const float e = static_cast<float>((*ax)[i]);
+        xf.push_back(e);
+        xf.push_back(std::nextafter(e, -std::numeric_limits<float>::infinity()));
+        xf.push_back(std::nextafter(e, std::numeric_limits<float>::infinity()));
+      }
+      xf.push_back(std::numeric_limits<float>::quiet_NaN());
+      xf.push_back(-1e30f);
+      std::vector<double> xd(xf.begin(), xf.end());
+      std::vector<int> jf, jd;
+      ax->index(xf.begin(), xf.end(), std::back_inserter(jf));
+      ax->index(xd.begin(), xd.end(), std::back_inserter(jd));
+      BOOST_TEST_EQ(jf.size(), xf.size());
+      BOOST_TEST_EQ(jd.size(), xf.size());
+      for (unsigned i = 0; i < xf.size(); ++i) {
+        // float input is binned like the same value in double precision
+        BOOST_TEST_EQ(jf[i], ax->index(xd[i]));
+        BOOST_TEST_EQ(jd[i], ax->index(xd[i]));
+      }
+    }
+    std::vector<float> x;
+    for (int i = -100; i < 400; ++i) {
+      x.push_back(i * 0.01f);
+    }
+    std::vector<int> j;
+    c.index(x.begin(), x.end(), std::back_inserter(j));
+    for (unsigned i = 0; i < x.size(); ++i) {
+      BOOST_TEST_EQ(j[i], c.index(x[i]));
+    }
+  }
+
+  // static_regular_axis
+  {
+    using axis4 = static_regular_axis<4, std::ratio<-2>, std::ratio<2>>;
+    static_assert(axis4::shape() == 6, "");
+    static_assert(static_regular_axis<4, std::ratio<0>, std::ratio<1>,
+                                      false>::shape() == 4,
+                  "");
+    axis4 a("x");
+    regular_axis<> b{4, -2, 2};
+    BOOST_TEST_EQ(a.label(), "x");
+    BOOST_TEST(a == axis4("x"));
+    BOOST_TEST_NOT(a == axis4());
+    for (double x : {-10., -2.1, -2.0, -1.1, 0.0, 0.9, 1.0, 1.99, 2.0, 10.}) {
+      BOOST_TEST_EQ(a.index(x), b.index(x));
+    }
+    BOOST_TEST_EQ(a.index(std::numeric_limits<double>::infinity()), 4);
+    BOOST_TEST_EQ(a.index(-std::numeric_limits<double>::infinity()), -1);
+    BOOST_TEST_EQ(a.index(std::numeric_limits<double>::quiet_NaN()), -1);
+    for (int i = -1; i <= a.bins() + 1; ++i) {
+      BOOST_TEST_EQ(a[i], b[i]);
+    }
+    static_regular_axis<3, std::ratio<1, 10>, std::ratio<4, 10>> c;
+    BOOST_TEST_EQ(c.min(), 0.1);
+    BOOST_TEST_EQ(c.index(0.25), 1);
+  }
+
+  // transform_axis
+  {
+    BOOST_TEST_THROWS(transform_axis<transform::log>(2, 0, 1), std::logic_error);
+    BOOST_TEST_THROWS(transform_axis<transform::log>(2, 2, 1), std::logic_error);
+    BOOST_TEST_THROWS(transform_axis<transform::pow>(2, 1, 2, "", true,
+                                                     transform::pow(-1)),
+                      std::logic_error);
+
+    transform_axis<transform::log> a{4, 1, 1e4};
+    BOOST_TEST_EQ(a[0], 1);
+    BOOST_TEST_EQ(a[4], 1e4);
+    BOOST_TEST_EQ(a[-1], -std::numeric_limits<double>::infinity());
+    BOOST_TEST_EQ(a[5], std::numeric_limits<double>::infinity());
+    BOOST_TEST_EQ(a.index(0.5), -1);
+    BOOST_TEST_EQ(a.index(5), 0);
+    BOOST_TEST_EQ(a.index(50), 1);
+    BOOST_TEST_EQ(a.index(9999), 3);
+    BOOST_TEST_EQ(a.index(1e4), 4);
+    BOOST_TEST_EQ(a.index(0), -1);
+    BOOST_TEST_EQ(a.index(-1), -1);
+    BOOST_TEST_EQ(a.index(std::numeric_limits<double>::infinity()), 4);
+    BOOST_TEST_EQ(a.index(std::numeric_limits<double>::quiet_NaN()), -1);
+    // the approximation is corrected at the exact edges
+    for (int i = 0; i <= a.bins(); ++i) {
+      BOOST_TEST_EQ(a.index(a[i]), i);
+      BOOST_TEST_EQ(a.index(std::nextafter(a[i], 0.0)), i - 1);
+    }
+
+    transform_axis<transform::log> b{1000, 1e-3, 1e6};
+    std::vector<double> x;
+    for (double v = 1e-4; v < 1e7; v *= 1.0001) {
+      x.push_back(v);
+    }
+    std::vector<int> idx;
+    b.index(x.begin(), x.end(), std::back_inserter(idx));
+    BOOST_TEST_EQ(idx.size(), x.size());
+    for (std::size_t i = 0; i < x.size(); ++i) {
+      const int j = b.index(x[i]);
+      BOOST_TEST_EQ(idx[i], j);
+      BOOST_TEST(b[j] <= x[i] && x[i] < b[j + 1]);
+      BOOST_TEST(std::abs(detail::fast_log(x[i]) - std::log(x[i])) < 1e-6);
+    }
+
+    transform_axis<transform::sqrt> c{2, 0, 4};
+    BOOST_TEST_EQ(c[1], 1);
+    BOOST_TEST_EQ(c.index(0.5), 0);
+    BOOST_TEST_EQ(c.index(1), 1);
+    BOOST_TEST_EQ(c.index(3.9), 1);
+
+    transform_axis<transform::pow> d{2, 0, 2, "", false, transform::pow(2)};
+    BOOST_TEST_EQ(d.index(1.4), 0);
+    BOOST_TEST_EQ(d.index(1.5), 1);
+    BOOST_TEST_EQ(d.index(2), 2);
+    BOOST_TEST_NOT(d == transform_axis<transform::pow>(2, 0, 2, "", false));
+    transform_axis<transform::pow> e;
+    e = d;
+    BOOST_TEST_EQ(e, d);
+  }
+
   // circular_axis
   {
     circular_axis<> a{4};
@@ -112,6 +238,40 @@ int main() {
     BOOST_TEST_EQ(a.index(std::numeric_limits<double>::quiet_NaN()), 0);
   }
 
+  // circular_axis agrees with floor and modulo
+  {
+    circular_axis<> a{36, 0.1};
+    circular_axis<float> b{7, -1, 3};
+    std::vector<double> x;
+    std::vector<float> y;
+    for (int i = -400; i <= 400; ++i) {
+      for (double d : {-1e-15, 0.0, 1e-15, 0.5}) {
+        x.push_back(a[i] + d);
+      }
+      y.push_back(b[i]);
+      y.push_back(std::nextafter(b[i], 0.f));
+      y.push_back(0.37f * i);
+    }
+    x.push_back(1e12);
+    x.push_back(-1e12);
+    for (double v : x) {
+      const double z = (v - a.phase()) / a.perimeter();
+      const int i = static_cast<int>(std::floor(z * a.bins())) % a.bins();
+      BOOST_TEST_EQ(a.index(v), i + (i < 0) * a.bins());
+    }
+    for (float v : y) {
+      const float z = (v - b.phase()) / b.perimeter();
+      const int i = static_cast<int>(std::floor(z * b.bins())) % b.bins();
+      BOOST_TEST_EQ(b.index(v), i + (i < 0) * b.bins());
+    }
+    std::vector<int> j;
+    a.index(x.begin(), x.end(), std::back_inserter(j));
+    BOOST_TEST_EQ(j.size(), x.size());
+    for (unsigned i = 0; i < x.size(); ++i) {
+      BOOST_TEST_EQ(j[i], a.index(x[i]));
+    }
+  }
+
   // variable_axis
   {
     variable_axis<> a{-1, 0, 1};
@@ -142,6 +302,34 @@ int main() {
     BOOST_TEST_EQ(a.index(std::numeric_limits<double>::quiet_NaN()), 2);
   }
 
+  // variable_axis with hint
+  {
+    std::vector<double> edges;
+    for (int i = 0; i <= 100; ++i) {
+      edges.push_back(i * i);
+    }
+    variable_axis<> a(edges.begin(), edges.end());
+    std::vector<double> x = {-1,   0,    0.5,  1,    9999, 10000, 10001,
+                             50.5, 2500, 2499, -100, 1e9,  -1e9,
+                             std::numeric_limits<double>::quiet_NaN()};
+    for (double v = -10; v < 10100; v += 7.5) {
+      x.push_back(v);
+    }
+    for (int h : {-5, -1, 0, 3, 50, 100, 101, 1000}) {
+      for (double v : x) {
+        int hint = h;
+        BOOST_TEST_EQ(a.index(v, hint), a.index(v));
+        BOOST_TEST_EQ(hint, a.index(v));
+      }
+    }
+    std::vector<int> j;
+    a.index(x.begin(), x.end(), std::back_inserter(j));
+    BOOST_TEST_EQ(j.size(), x.size());
+    for (unsigned i = 0; i < x.size(); ++i) {
+      BOOST_TEST_EQ(j[i], a.index(x[i]));
+    }
+  }
+
   // integer_axis
   {
     integer_axis a{-1, 1};
@@ -167,6 +355,142 @@ int main() {
     BOOST_TEST_EQ(a.index(10), 3);
   }
 
+  // lookup_axis
+  {
+    BOOST_TEST_THROWS(lookup_axis<std::uint8_t>({1}), std::logic_error);
+    BOOST_TEST_THROWS(lookup_axis<std::uint8_t>({1, 1}), std::logic_error);
+    BOOST_TEST_THROWS(lookup_axis<std::uint8_t>({0, 257}), std::logic_error);
+    lookup_axis<std::uint8_t> a{2, 4, 10, 256};
+    BOOST_TEST_EQ(a.bins(), 3);
+    BOOST_TEST_EQ(a[-1], 0);
+    BOOST_TEST_EQ(a[2], 10);
+    BOOST_TEST_EQ(a[4], 256);
+    BOOST_TEST(a == lookup_axis<std::uint8_t>({2, 4, 10, 256}));
+    BOOST_TEST_NOT(a == lookup_axis<std::uint8_t>({2, 4, 11, 256}));
+    variable_axis<> v{2, 4, 10, 256};
+    std::vector<std::uint8_t> x;
+    for (int i = 0; i < 256; ++i) {
+      BOOST_TEST_EQ(a.index(i), v.index(i));
+      x.push_back(i);
+    }
+    std::vector<int> j;
+    a.index(x.begin(), x.end(), std::back_inserter(j));
+    BOOST_TEST_EQ(j.size(), 256);
+    for (int i = 0; i < 256; ++i) {
+      BOOST_TEST_EQ(j[i], a.index(i));
+    }
+
+    lookup_axis<> b{0, 1000, 1001, 65535};
+    BOOST_TEST_EQ(b.index(999), 0);
+    BOOST_TEST_EQ(b.index(1000), 1);
+    BOOST_TEST_EQ(b.index(65535), 3);
+
+    // wider inputs are range-checked instead of wrapped into the domain
+    BOOST_TEST_EQ(b.index(-1), -1);
+    BOOST_TEST_EQ(b.index(65536), 3);
+    BOOST_TEST_EQ(b.index(70000), 3);
+    BOOST_TEST_EQ(b.index(std::uint64_t(1) << 40), 3);
+    BOOST_TEST_EQ(b.index(-0.5), -1);
+    BOOST_TEST_EQ(b.index(999.5), 0);
+    BOOST_TEST_EQ(b.index(1e10), 3);
+    BOOST_TEST_EQ(b.index(std::numeric_limits<double>::quiet_NaN()), 3);
+    const std::vector<long> w = {-1, 0, 1000, 4464, 65535, 65536, 70000};
+    j.clear();
+    b.index(w.begin(), w.end(), std::back_inserter(j));
+    BOOST_TEST(j == std::vector<int>({-1, 0, 1, 2, 3, 3, 3}));
+
+    // the overflow bin starts at the end of the domain
+    lookup_axis<> c{0, 1000, 65536};
+    auto it = c.begin() + 3;
+    BOOST_TEST_EQ(it->idx, 2);
+    BOOST_TEST_EQ(it->value, 65536);
+  }
+
+  // shift_axis
+  {
+    BOOST_TEST_THROWS(shift_axis(1, 0, 31), std::logic_error);
+    BOOST_TEST_THROWS(shift_axis(1 << 20, 0, 11), std::logic_error);
+    BOOST_TEST_THROWS(shift_axis(2, std::numeric_limits<int>::max(), 0),
+                      std::logic_error);
+    shift_axis a{4, -8, 2};
+    BOOST_TEST_EQ(a.width(), 4);
+    BOOST_TEST_EQ(a[0], -8);
+    BOOST_TEST_EQ(a[4], 8);
+    BOOST_TEST(a == shift_axis(4, -8, 2));
+    BOOST_TEST_NOT(a == shift_axis(4, -8, 1));
+    regular_axis<> r{4, -8, 8};
+    std::vector<int> x, j;
+    for (int i = -12; i <= 12; ++i) {
+      BOOST_TEST_EQ(a.index(i), r.index(i));
+      x.push_back(i);
+    }
+    x.push_back(std::numeric_limits<int>::min());
+    x.push_back(std::numeric_limits<int>::max());
+    BOOST_TEST_EQ(a.index(x[x.size() - 2]), -1);
+    BOOST_TEST_EQ(a.index(x.back()), 4);
+    for (int i = 0; i < 5; ++i) { // more than one block
+      x.insert(x.end(), x.begin(), x.begin() + 27);
+    }
+    a.index(x.begin(), x.end(), std::back_inserter(j));
+    BOOST_TEST_EQ(j.size(), x.size());
+    for (unsigned i = 0; i < x.size(); ++i) {
+      BOOST_TEST_EQ(j[i], a.index(x[i]));
+    }
+  }
+
+  // log_linear_axis
+  {
+    BOOST_TEST_THROWS(log_linear_axis(0, 100), std::logic_error);
+    BOOST_TEST_THROWS(log_linear_axis(25, 100), std::logic_error);
+    BOOST_TEST_THROWS(log_linear_axis(3, std::uint64_t(1) << 63),
+                      std::logic_error);
+
+    log_linear_axis a{3, 1000};
+    BOOST_TEST_EQ(a.bins(), 36);
+    BOOST_TEST_EQ(a.index(0), 0);
+    BOOST_TEST_EQ(a.index(7), 7);
+    BOOST_TEST_EQ(a.index(8), 8);
+    BOOST_TEST_EQ(a.index(9), 8);
+    BOOST_TEST_EQ(a.index(10), 9);
+    BOOST_TEST_EQ(a.index(15), 11);
+    BOOST_TEST_EQ(a.index(16), 12);
+    BOOST_TEST_EQ(a.index(1000), 35);
+    BOOST_TEST_EQ(a.index(1001), 36);
+    BOOST_TEST_EQ(a[8], 8u);
+    BOOST_TEST_EQ(a[9], 10u);
+    BOOST_TEST_EQ(a[12], 16u);
+    BOOST_TEST_EQ(a[-1], 0u);
+    for (std::uint64_t x = 0; x <= 1000; ++x) {
+      const int j = a.index(x);
+      BOOST_TEST(a[j] <= x && x < a[j + 1]);
+      if (x >= 8) {
+        BOOST_TEST_LE(a[j + 1] - a[j], a[j] / 4);
+      }
+    }
+
+    log_linear_axis b{10, (std::uint64_t(1) << 62) + 12345};
+    const std::uint64_t x = (std::uint64_t(1) << 62) + 1;
+    BOOST_TEST(b[b.index(x)] <= x && x < b[b.index(x) + 1]);
+    BOOST_TEST_EQ(b.index(x), b.bins() - 1);
+    BOOST_TEST_NOT(a == b);
+
+    // the largest axis
+    const std::uint64_t m = ~(std::uint64_t(1) << 63);
+    log_linear_axis c{24, m};
+    BOOST_TEST_EQ(c.bins(), 41 * (1 << 23));
+    BOOST_TEST_EQ(c.index(m), c.bins() - 1);
+    BOOST_TEST_EQ(c.index(m - 1), c.bins() - 1);
+    BOOST_TEST_EQ(c.index(std::uint64_t(1) << 63), c.bins());
+    BOOST_TEST_EQ(c[c.bins()], std::uint64_t(1) << 63);
+    BOOST_TEST_EQ(c[1 << 24], std::uint64_t(1) << 24);
+    BOOST_TEST_EQ(c.index((std::uint64_t(1) << 24) - 1), (1 << 24) - 1);
+    for (std::uint64_t y = 1; y < m / 3; y = 3 * y + 1) {
+      const int j = c.index(y);
+      BOOST_TEST(c[j] <= y && y < c[j + 1]);
+      BOOST_TEST_EQ(c.index(c[j]), j);
+    }
+  }
+
   // category_axis
   {
     category_axis a{{"A", "B", "C"}};
@@ -186,17 +510,133 @@ int main() {
     BOOST_TEST_EQ(a.index(0), 0);
     BOOST_TEST_EQ(a.index(1), 1);
     BOOST_TEST_EQ(a.index(2), 2);
+    BOOST_TEST_EQ(a.index(3), 3);
+    BOOST_TEST_EQ(a.shape(), 3);
+  }
+
+  // category_axis lookup by name
+  {
+    category_axis a{{"GET", "POST", "PUT", "", "GET"}, "", true};
+    BOOST_TEST(a.overflow());
+    BOOST_TEST_EQ(a.shape(), 6);
+    BOOST_TEST_EQ(a.index("GET"), 0);
+    BOOST_TEST_EQ(a.index(std::string("PUT")), 2);
+    BOOST_TEST_EQ(a.index(""), 3);
+    BOOST_TEST_EQ(a.index("DELETE"), 5);
+    BOOST_TEST_EQ(a.index(-1), 5);
+    BOOST_TEST_NOT(a == category_axis({"GET", "POST", "PUT", "", "GET"}));
+
+    std::vector<std::string> keys;
+    for (int i = 0; i < 1000; ++i) {
+      keys.push_back("k" + std::to_string(i));
+    }
+    category_axis b(keys.begin(), keys.end());
+    category_axis c = b;
+    std::vector<std::string> query(keys.rbegin(), keys.rend());
+    query.push_back("unknown");
+    std::vector<int> idx;
+    c.index(query.begin(), query.end(), std::back_inserter(idx));
+    BOOST_TEST_EQ(idx.size(), 1001u);
+    for (int i = 0; i < 1000; ++i) {
+      BOOST_TEST_EQ(idx[i], 999 - i);
+    }
+    BOOST_TEST_EQ(idx[1000], 1000);
+
+    category_axis d;
+    BOOST_TEST_EQ(d.index("A"), 0);
+  }
+
+  // growth
+  {
+    BOOST_TEST_THROWS(regular_axis<>(4, 0, 4, "", true, true),
+                      std::logic_error);
+    BOOST_TEST_THROWS(integer_axis(0, 3, "", true, true), std::logic_error);
+
+    regular_axis<> a{4, 0, 4, "", false, true};
+    BOOST_TEST(a.growth());
+    BOOST_TEST_NOT(a == regular_axis<>(4, 0, 4, "", false));
+    BOOST_TEST_EQ(a.grow(1), 0);
+    BOOST_TEST_EQ(a.bins(), 4);
+    BOOST_TEST_EQ(a.grow(5.5), 0);
+    BOOST_TEST_EQ(a.bins(), 6);
+    BOOST_TEST_EQ(a.index(5.5), 5);
+    // at least a quarter of the bins is added
+    BOOST_TEST_EQ(a.grow(-0.5), 2);
+    BOOST_TEST_EQ(a.bins(), 8);
+    BOOST_TEST_EQ(a.shape(), 8);
+    BOOST_TEST_EQ(a[0], -2);
+    BOOST_TEST_EQ(a[8], 6);
+    BOOST_TEST_EQ(a.index(-0.5), 1);
+    BOOST_TEST_EQ(a.grow(std::numeric_limits<double>::infinity()), 0);
+    BOOST_TEST_EQ(a.grow(std::numeric_limits<double>::quiet_NaN()), 0);
+    BOOST_TEST_EQ(a.bins(), 8);
+
+    // repeated downward growth keeps the edges on the initial grid
+    regular_axis<> g{3, 0.1, 0.4, "", false, true};
+    const double delta = (0.4 - 0.1) / 3;
+    for (int i = 0; i < 40; ++i) {
+      BOOST_TEST_GT(g.grow(g[0] - 0.5 * delta), 0);
+    }
+    const int below = g.bins() - 3;
+    for (int i = 0; i <= g.bins(); ++i) {
+      BOOST_TEST_EQ(g[i], 0.1 + (i - below) * delta);
+    }
+    BOOST_TEST_EQ(g.index(0.1 + 0.5 * delta), below);
+    BOOST_TEST_EQ(g.index(0.1 - 0.5 * delta), below - 1);
+
+    integer_axis b{0, 3, "", false, true};
+    BOOST_TEST_EQ(b.grow(10), 0);
+    BOOST_TEST_EQ(b.bins(), 11);
+    BOOST_TEST_EQ(b.grow(-1), 3);
+    BOOST_TEST_EQ(b.bins(), 14);
+    BOOST_TEST_EQ(b[0], -3);
+    BOOST_TEST_EQ(b.index(10), 13);
+
+    integer_axis c{0, 3};
+    BOOST_TEST_EQ(c.grow(10), 0);
+    BOOST_TEST_EQ(c.bins(), 4);
+
+    BOOST_TEST_THROWS(category_axis({"A"}, "", true, true), std::logic_error);
+    category_axis d({}, "", false, true);
+    BOOST_TEST(d.growth());
+    BOOST_TEST_EQ(d.bins(), 0);
+    BOOST_TEST_EQ(d.index("t0"), 0);
+    for (int i = 0; i < 100; ++i) {
+      BOOST_TEST_EQ(d.grow("t" + std::to_string(i)), 0);
+      BOOST_TEST_EQ(d.grow("t" + std::to_string(i / 2)), 0);
+    }
+    BOOST_TEST_EQ(d.bins(), 100);
+    // storage is reserved for a power of two of categories
+    BOOST_TEST_EQ(d.shape(), 128);
+    for (int i = 0; i < 100; ++i) {
+      BOOST_TEST_EQ(d.index("t" + std::to_string(i)), i);
+      BOOST_TEST_EQ(d[i], "t" + std::to_string(i));
+    }
+    BOOST_TEST_EQ(d.index("t100"), 128);
+    BOOST_TEST_EQ(d.index(100), 128);
+    std::vector<std::string> names;
+    for (int i = 0; i < d.bins(); ++i) {
+      names.push_back(d[i]);
+    }
+    BOOST_TEST(d == category_axis(names.begin(), names.end(), "", false, true));
+    category_axis e{{"A"}};
+    BOOST_TEST_EQ(e.grow("B"), 0);
+    BOOST_TEST_EQ(e.bins(), 1);
   }
 
   // iterators
   {
     test_real_axis_iterator(regular_axis<>(5, 0, 1, "", false), 0, 5);
     test_real_axis_iterator(regular_axis<>(5, 0, 1, "", true), -1, 6);
+    test_real_axis_iterator(
+        static_regular_axis<5, std::ratio<0>, std::ratio<1>>(), -1, 6);
     test_real_axis_iterator(circular_axis<>(5, 0, 1, ""), 0, 5);
     test_real_axis_iterator(variable_axis<>({1, 2, 3}, "", false), 0, 2);
     test_real_axis_iterator(variable_axis<>({1, 2, 3}, "", true), -1, 3);
     test_axis_iterator(integer_axis(0, 4, "", false), 0, 5);
     test_axis_iterator(integer_axis(0, 4, "", true), -1, 6);
+    test_axis_iterator(shift_axis(4, 0, 1, "", false), 0, 4);
+    test_axis_iterator(lookup_axis<>({0, 1, 3}, "", true), -1, 3);
     test_axis_iterator(category_axis({"A", "B", "C"}), 0, 3);
   }
 
@@ -231,16 +671,28 @@ int main() {
     axes.push_back(variable_axis<>{{-1, 0, 1}, "variable", false});
     axes.push_back(category_axis{{"A", "B", "C"}, "category"});
     axes.push_back(integer_axis{-1, 1, "integer", false});
+    axes.push_back(integer_axis{-1, 1, "", false, true});
+    axes.push_back(category_axis{{"A"}, "", true});
+    axes.push_back(category_axis{{}, "", false, true});
     std::ostringstream os;
     for (const auto &a : axes) {
       os << a;
     }
+    os << log_linear_axis(3, 1000, "l")
+       << transform_axis<transform::log>(2, 1, 100, "t", false)
+       << transform_axis<transform::pow>(2, 0, 1, "", true, transform::pow(2));
     const std::string ref =
         "regular_axis(2, -1, 1, label='regular', uoflow=False)"
         "circular_axis(4, phase=0.1, perimeter=1, label='polar')"
         "variable_axis(-1, 0, 1, label='variable', uoflow=False)"
         "category_axis('A', 'B', 'C', label='category')"
-        "integer_axis(-1, 1, label='integer', uoflow=False)";
+        "integer_axis(-1, 1, label='integer', uoflow=False)"
+        "integer_axis(-1, 1, uoflow=False, growth=True)"
+        "category_axis('A', overflow=True)"
+        "category_axis(growth=True)"
+        "log_linear_axis(3, 1000, label='l')"
+        "transform_axis(2, 1, 100, transform=log, label='t', uoflow=False)"
+        "transform_axis(2, 0, 1, transform=pow(2))";
     BOOST_TEST_EQ(os.str(), ref);
   }
 
@@ -289,19 +741,19 @@ int main() {
     BOOST_TEST_NOT(detail::axes_equal(std_vector2, std_vector3));
     BOOST_TEST_NOT(detail::axes_equal(std_vector3, std_vector4));
 
-    boost::fusion::vector<regular_axis<>, variable_axis<>, category_axis> fusion_vector1 = {
+    boost::fusion::vector<regular_axis<>, variable_axis<>, category_axis> fusion_vector1{
       regular_axis<>{2, -1, 1},
       variable_axis<>{-1, 0, 1},
       category_axis{"A", "B", "C"}
     };
 
-    boost::fusion::vector<regular_axis<>, variable_axis<>, category_axis> fusion_vector2 = {
+    boost::fusion::vector<regular_axis<>, variable_axis<>, category_axis> fusion_vector2{
       regular_axis<>{2, -1, 1},
       variable_axis<>{-1, 0, 1},
       category_axis{"A", "B"}
     };
 
-    boost::fusion::vector<regular_axis<>, variable_axis<>> fusion_vector3 = {
+    boost::fusion::vector<regular_axis<>, variable_axis<>> fusion_vector3{
       regular_axis<>{2, -1, 1},
       variable_axis<>{-1, 0, 1}
     };
@@ -329,7 +781,7 @@ int main() {
     detail::axes_assign(std_vector2, std_vector1);
     BOOST_TEST(detail::axes_equal(std_vector2, std_vector1));
 
-    boost::fusion::vector<regular_axis<>, variable_axis<>, category_axis> fusion_vector1 = {
+    boost::fusion::vector<regular_axis<>, variable_axis<>, category_axis> fusion_vector1{
       regular_axis<>{2, -3, 3},
       variable_axis<>{-3, 0, 3},
       category_axis{"A", "B", "C", "D"}
@@ -338,7 +790,7 @@ int main() {
     detail::axes_assign(fusion_vector1, std_vector1);
     BOOST_TEST(detail::axes_equal(fusion_vector1, std_vector1));
 
-    boost::fusion::vector<regular_axis<>, variable_axis<>, category_axis> fusion_vector2 = {
+    boost::fusion::vector<regular_axis<>, variable_axis<>, category_axis> fusion_vector2{
       regular_axis<>{2, -1, 1},
       variable_axis<>{-1, 0, 1},
       category_axis{"A", "B"}
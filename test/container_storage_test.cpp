@@ -11,10 +11,15 @@
 #include <boost/histogram/detail/utility.hpp>
 #include <boost/histogram/storage/adaptive_storage.hpp>
 #include <boost/histogram/storage/container_storage.hpp>
+#include <boost/histogram/storage/huge_page_allocator.hpp>
 #include <deque>
 #include <limits>
 #include <vector>
 
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
 int main() {
   using namespace boost::histogram;
 
@@ -117,5 +122,52 @@ int main() {
     BOOST_TEST_EQ(b.size(), 0u);
   }
 
+  // huge_page_allocator
+  {
+    using vector_type = std::vector<unsigned, huge_page_allocator<unsigned>>;
+    const std::size_t n = detail::huge_page_size;
+    container_storage<vector_type> a(n);
+    BOOST_TEST_EQ(a.size(), n);
+    BOOST_TEST_EQ(a.value(n - 1), 0u);
+    a.increase(n - 1);
+    a.increase(n - 1, 2);
+    BOOST_TEST_EQ(a.value(n - 1), 3u);
+    container_storage<std::vector<unsigned>> b(a);
+    BOOST_TEST(b == a);
+    container_storage<
+        std::vector<unsigned, interleaved_huge_page_allocator<unsigned>>>
+        c(a);
+    BOOST_TEST(c == a);
+    container_storage<
+        std::vector<unsigned, first_touch_huge_page_allocator<unsigned>>>
+        d(a);
+    BOOST_TEST(d == a);
+  }
+
+  // huge_page_allocator with a size which is not a multiple of the page size
+  {
+    const std::size_t bytes = 3 * detail::huge_page_size / 2 + 8;
+    BOOST_TEST_EQ(detail::huge_page_round(bytes), 2 * detail::huge_page_size);
+#if defined(__linux__)
+    for (const auto policy : {numa_policy::local, numa_policy::interleave,
+                              numa_policy::first_touch}) {
+      auto *p = static_cast<char *>(detail::map_huge_pages(bytes, policy));
+      p[0] = 1;
+      p[bytes - 1] = 1;
+      BOOST_TEST(detail::unmap_huge_pages(p, bytes));
+      // the whole mapping is gone, including the rounded-up tail
+      BOOST_TEST_NE(::msync(p, detail::huge_page_size, MS_ASYNC), 0);
+      BOOST_TEST_NE(::msync(p + detail::huge_page_size,
+                            detail::huge_page_size, MS_ASYNC),
+                    0);
+    }
+#endif
+    using vector_type = std::vector<char, huge_page_allocator<char>>;
+    for (int k = 0; k < 3; ++k) {
+      vector_type v(bytes, 1);
+      BOOST_TEST_EQ(v.back(), 1);
+    }
+  }
+
   return boost::report_errors();
 }
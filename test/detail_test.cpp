@@ -5,10 +5,13 @@
 // or copy at http://www.boost.org/LICENSE_1_0.txt)
 
 #include <boost/core/lightweight_test.hpp>
+#include <boost/histogram/detail/remap.hpp>
 #include <boost/histogram/detail/utility.hpp>
 #include <boost/histogram/detail/weight.hpp>
+#include <boost/histogram/storage/container_storage.hpp>
 #include <cstring>
 #include <sstream>
+#include <vector>
 using namespace boost::histogram::detail;
 
 int main() {
@@ -45,5 +48,29 @@ int main() {
     BOOST_TEST_EQ(os.str(), std::string("'\\\'abc\\\''"));
   }
 
+  // remap_range in chunks
+  {
+    using storage = boost::histogram::container_storage<std::vector<int>>;
+    storage s(3 * 4 * 5);
+    for (std::size_t i = 0; i < s.size(); ++i) {
+      s.add(i, i, i);
+    }
+    const auto maps = project_remap({3, 4, 5}, {2, 0});
+    std::vector<std::vector<std::ptrdiff_t>> off(3);
+    for (unsigned k = 0; k < 3; ++k) {
+      for (const auto j : maps[k].pos) {
+        off[k].push_back(j * maps[k].stride);
+      }
+    }
+    std::vector<double> whole(2 * 15, 0.0), chunked(2 * 15, 0.0);
+    remap_range(s, off, 0, s.size(), whole.data());
+    remap_range(s, off, 0, 7, chunked.data());
+    remap_range(s, off, 7, 31, chunked.data());
+    remap_range(s, off, 31, s.size(), chunked.data());
+    BOOST_TEST(whole == chunked);
+    // target bin (i2, i0) = (2, 1) collects i0 + 3 * i1 + 12 * i2 for all i1
+    BOOST_TEST_EQ(whole[2 * (2 + 5 * 1)], 4 * (1 + 24) + 3 * (0 + 1 + 2 + 3));
+  }
+
   return boost::report_errors();
 }
@@ -15,10 +15,12 @@
 #include <boost/histogram/serialization.hpp>
 #include <boost/histogram/storage/adaptive_storage.hpp>
 #include <boost/histogram/storage/container_storage.hpp>
+#include <boost/histogram/summed_area_table.hpp>
 #include <boost/histogram/utility.hpp>
 #include <boost/mpl/vector.hpp>
 #include <limits>
 #include <sstream>
+#include <utility>
 #include <vector>
 
 int main() {
@@ -478,13 +480,428 @@ int main() {
     BOOST_TEST_EQ(h.sum(), 20.0);
   }
 
+  // bin_iterator
+  {
+    auto h = make_dynamic_histogram(integer_axis(0, 1),
+                                    regular_axis<>(2, -1, 1, "", false));
+    h.fill(0, -1);
+    h.fill(1, 0.5);
+    h.fill(-1, 0.5);
+    h.wfill(3, 2, -0.5);
+
+    std::vector<std::pair<int, int>> idx;
+    double sum = 0;
+    for (const auto &b : indexed(h)) {
+      BOOST_TEST_EQ(b.dim(), 2);
+      BOOST_TEST_EQ(b.value, h.value(b.idx(0), b.idx(1)));
+      BOOST_TEST_EQ(b.variance, h.variance(b.idx(0), b.idx(1)));
+      idx.emplace_back(b.idx(0), b.idx(1));
+      sum += b.value;
+    }
+    BOOST_TEST_EQ(idx.size(), h.size());
+    BOOST_TEST_EQ(sum, h.sum());
+    BOOST_TEST(idx[0] == std::make_pair(0, 0));
+    BOOST_TEST(idx[2] == std::make_pair(2, 0));
+    BOOST_TEST(idx[3] == std::make_pair(-1, 0));
+    BOOST_TEST(idx[4] == std::make_pair(0, 1));
+    BOOST_TEST(idx[7] == std::make_pair(-1, 1));
+
+    unsigned n = 0;
+    h.for_each_bin([&](const indexed_bin<double> &b) {
+      BOOST_TEST(idx[n++] == std::make_pair(b.idx(0), b.idx(1)));
+      BOOST_TEST_EQ(b.value, h.value(b.idx(0), b.idx(1)));
+      BOOST_TEST_EQ(b.variance, h.variance(b.idx(0), b.idx(1)));
+    });
+    BOOST_TEST_EQ(n, h.size());
+
+    // bins keep their indices when copied
+    std::vector<indexed_bin<double>> bins;
+    h.for_each_bin(
+        [&bins](const indexed_bin<double> &b) { bins.push_back(b); });
+    BOOST_TEST_EQ(bins.size(), h.size());
+    for (unsigned i = 0; i < bins.size(); ++i) {
+      BOOST_TEST(idx[i] == std::make_pair(bins[i].idx(0), bins[i].idx(1)));
+    }
+  }
+
+  // project
+  {
+    auto h = make_dynamic_histogram(integer_axis(0, 1), integer_axis(0, 2),
+                                    integer_axis(0, 3, "", false));
+    h.fill(0, 0, 0);
+    h.fill(0, 1, 1);
+    h.fill(1, 1, 2);
+    h.fill(1, 2, 2);
+    h.fill(-1, 3, 3);
+    h.wfill(2, 1, 0, 3);
+
+    auto h0 = h.project(0);
+    BOOST_TEST_EQ(h0.dim(), 1);
+    BOOST_TEST_EQ(h0.axis(0), h.axis(0));
+    BOOST_TEST_EQ(h0.sum(), h.sum());
+    BOOST_TEST_EQ(h0.value(-1), 1);
+    BOOST_TEST_EQ(h0.value(0), 2);
+    BOOST_TEST_EQ(h0.value(1), 4);
+    BOOST_TEST_EQ(h0.variance(1), 6);
+    BOOST_TEST_EQ(h0.value(2), 0);
+
+    std::vector<unsigned> keep = {2, 1};
+    auto h21 = h.project(keep.begin(), keep.end());
+    BOOST_TEST_EQ(h21.dim(), 2);
+    BOOST_TEST_EQ(h21.axis(0), h.axis(2));
+    BOOST_TEST_EQ(h21.axis(1), h.axis(1));
+    BOOST_TEST_EQ(h21.sum(), h.sum());
+    for (int i = 0; i < 4; ++i) {
+      for (int j = -1; j < 4; ++j) {
+        double v = 0, var = 0;
+        for (int k = -1; k < 3; ++k) {
+          v += h.value(k, j, i);
+          var += h.variance(k, j, i);
+        }
+        BOOST_TEST_EQ(h21.value(i, j), v);
+        BOOST_TEST_EQ(h21.variance(i, j), var);
+      }
+    }
+    BOOST_TEST(h.project(0, 1, 2) == h);
+
+    BOOST_TEST_THROWS(h.project(), std::logic_error);
+    BOOST_TEST_THROWS(h.project(3), std::out_of_range);
+    BOOST_TEST_THROWS(h.project(1, 1), std::logic_error);
+  }
+
+  // add_marginal
+  {
+    auto h = make_dynamic_histogram(integer_axis(0, 1), integer_axis(0, 2),
+                                    integer_axis(0, 3, "", false));
+    h.fill(0, 0, 0);
+    h.add_marginal(0);
+    h.add_marginal(2, 1);
+    h.fill(0, 1, 1);
+    h.fill(1, 1, 2);
+    h.fill(1, 2, 2);
+    h.fill(-1, 3, 3);
+    h.fill(0, 0, 4); // dropped, no underflow/overflow on last axis
+    h.wfill(2, 1, 0, 3);
+    const double x[] = {1, 2, 2};
+    h.fill(x, x + 3);
+    h.wfill(3, x, x + 3);
+
+    BOOST_TEST(h.marginal(0) == h.project(0));
+    BOOST_TEST(h.marginal(2, 1) == h.project(2, 1));
+    BOOST_TEST_EQ(h.marginal(0).value(1), 8);
+    BOOST_TEST_EQ(h.marginal(0).variance(1), 16);
+    BOOST_TEST_THROWS(h.marginal(1), std::logic_error);
+    BOOST_TEST_THROWS(h.add_marginal(3), std::out_of_range);
+
+    auto h2 = h;
+    h2 += h;
+    BOOST_TEST(h2.marginal(2, 1) == h2.project(2, 1));
+    BOOST_TEST_EQ(h2.marginal(0).value(1), 16);
+  }
+
+  // integral
+  {
+    auto h = make_dynamic_histogram(integer_axis(0, 2), integer_axis(0, 3, "", false),
+                                   regular_axis<>(2, 0, 1));
+    for (int i = -1; i < 4; ++i) {
+      for (int j = 0; j < 4; ++j) {
+        for (int k = 0; k < 4; ++k) {
+          if ((i + 2 * j + k) % 3) {
+            h.wfill(1 + (i + j) % 2, i, j, 0.4 * k - 0.2);
+          }
+        }
+      }
+    }
+    auto brute = [&h](int i0, int j0, int k0, int i1, int j1, int k1) {
+      std::pair<double, double> s(0, 0);
+      for (int i = i0; i < i1; ++i) {
+        for (int j = j0; j < j1; ++j) {
+          for (int k = k0; k < k1; ++k) {
+            s.first += h.value(i, j, k);
+            s.second += h.variance(i, j, k);
+          }
+        }
+      }
+      return s;
+    };
+    summed_area_table t(h);
+    BOOST_TEST_EQ(t.dim(), 3u);
+    BOOST_TEST_EQ(t.integral(-1, 0, -1, 4, 4, 3), h.sum());
+    for (int i0 = -1; i0 < 4; ++i0) {
+      for (int i1 = i0; i1 < 5; ++i1) {
+        for (int j0 = 0; j0 < 4; ++j0) {
+          for (int k1 = -1; k1 < 4; ++k1) {
+            const auto s = brute(i0, j0, -1, i1, 4, k1);
+            BOOST_TEST_EQ(t.integral(i0, j0, -1, i1, 4, k1), s.first);
+            BOOST_TEST_EQ(t.integral_variance(i0, j0, -1, i1, 4, k1),
+                          s.second);
+          }
+        }
+      }
+    }
+
+    // changes of the histogram make the table stale
+    const double before = t.integral(1, 1, 1, 2, 2, 2);
+    BOOST_TEST(t.is_current());
+    h.fill(1, 1, 0.5);
+    BOOST_TEST(!t.is_current());
+    BOOST_TEST_THROWS(t.integral(1, 1, 1, 2, 2, 2), std::logic_error);
+    t.rebuild(h);
+    BOOST_TEST_EQ(t.integral(1, 1, 1, 2, 2, 2), before + 1);
+    const double row[] = {0, 0, 0.5};
+    const bool mask[] = {true};
+    h.masked_fill_n(1, mask, row);
+    BOOST_TEST(!t.is_current());
+    t.rebuild(h);
+    h.wfill(2, row, row + 3);
+    BOOST_TEST(!t.is_current());
+    t.rebuild(h);
+    auto h3 = h;
+    h = std::move(h3);
+    BOOST_TEST(!t.is_current());
+    const summed_area_table t2(h);
+    BOOST_TEST_EQ(t2.integral(1, 1, 1, 2, 2, 2), before + 1);
+    BOOST_TEST_EQ(t2.integral(1, 1, 1, 2, 2, 2), h.value(1, 1, 1));
+    BOOST_TEST_EQ(t2.integral(0, 0, 0, 3, 4, 2), brute(0, 0, 0, 3, 4, 2).first);
+    const int lo[] = {0, 0, 0}, hi[] = {3, 4, 2};
+    BOOST_TEST_EQ(t2.integral(lo, hi), brute(0, 0, 0, 3, 4, 2).first);
+    BOOST_TEST_EQ(t2.integral_variance(lo, hi), brute(0, 0, 0, 3, 4, 2).second);
+
+    BOOST_TEST_THROWS(t2.integral(-2, 0, 0, 1, 1, 1), std::out_of_range);
+    BOOST_TEST_THROWS(t2.integral(0, -1, 0, 1, 1, 1), std::out_of_range);
+    BOOST_TEST_THROWS(t2.integral(0, 0, 0, 1, 5, 1), std::out_of_range);
+    BOOST_TEST_THROWS(t2.integral(1, 0, 0, 0, 1, 1), std::out_of_range);
+  }
+
+  // rebin
+  {
+    auto h = make_dynamic_histogram(regular_axis<>(6, 0, 6), integer_axis(0, 4),
+                                    circular_axis<>(4, 0, 4));
+    for (int i = -1; i < 8; ++i) {
+      for (int j = -1; j < 6; ++j) {
+        h.wfill(1 + (i + j) % 3, i + 0.5, j, i + j);
+      }
+    }
+
+    auto h0 = h.rebin(0, 2);
+    BOOST_TEST(boost::get<regular_axis<>>(h0.axis(0)) == regular_axis<>(3, 0, 6));
+    BOOST_TEST_EQ(h0.axis(1), h.axis(1));
+    BOOST_TEST_EQ(h0.sum(), h.sum());
+    for (int j = -1; j < 6; ++j) {
+      for (int k = 0; k < 4; ++k) {
+        for (int i = 0; i < 3; ++i) {
+          BOOST_TEST_EQ(h0.value(i, j, k),
+                        h.value(2 * i, j, k) + h.value(2 * i + 1, j, k));
+          BOOST_TEST_EQ(h0.variance(i, j, k),
+                        h.variance(2 * i, j, k) + h.variance(2 * i + 1, j, k));
+        }
+        BOOST_TEST_EQ(h0.value(-1, j, k), h.value(-1, j, k));
+        BOOST_TEST_EQ(h0.value(3, j, k), h.value(6, j, k));
+      }
+    }
+
+    auto h1 = h.rebin(1, 2);
+    BOOST_TEST(boost::get<regular_axis<>>(h1.axis(1)) == regular_axis<>(2, 0, 4));
+    BOOST_TEST_EQ(h1.sum(), h.sum());
+    BOOST_TEST_EQ(h1.value(0, 2, 1), h.value(0, 4, 1) + h.value(0, 5, 1));
+
+    auto h2 = h.rebin(2, 2);
+    BOOST_TEST(boost::get<circular_axis<>>(h2.axis(2)) == circular_axis<>(2, 0, 4));
+    BOOST_TEST_EQ(h2.value(1, 1, 1), h.value(1, 1, 2) + h.value(1, 1, 3));
+
+    BOOST_TEST_THROWS(h.rebin(2, 3), std::logic_error);
+    BOOST_TEST_THROWS(h.rebin(3, 2), std::out_of_range);
+    auto h3 = make_dynamic_histogram(category_axis{"A", "B"});
+    BOOST_TEST_THROWS(h3.rebin(0, 2), std::logic_error);
+    auto h4 = histogram<Dynamic, mpl::vector<integer_axis>>(integer_axis(0, 3));
+    BOOST_TEST_THROWS(h4.rebin(0, 2), std::logic_error);
+  }
+
+  // slice
+  {
+    auto h = make_dynamic_histogram(variable_axis<>({0, 1, 2, 4, 8}),
+                                    circular_axis<>(4, 0, 4),
+                                    category_axis{"A", "B", "C"});
+    for (int i = -1; i < 9; ++i) {
+      for (int j = 0; j < 4; ++j) {
+        h.wfill(1 + (i + j) % 3, i + 0.5, j, (i + 3) % 3);
+      }
+    }
+
+    auto h0 = h.slice(0, 1, 3);
+    BOOST_TEST(boost::get<variable_axis<>>(h0.axis(0)) ==
+               variable_axis<>({1, 2, 4}));
+    BOOST_TEST_EQ(h0.sum(), h.sum());
+    for (int j = 0; j < 4; ++j) {
+      for (int k = 0; k < 3; ++k) {
+        BOOST_TEST_EQ(h0.value(0, j, k), h.value(1, j, k));
+        BOOST_TEST_EQ(h0.value(1, j, k), h.value(2, j, k));
+        BOOST_TEST_EQ(h0.value(-1, j, k), h.value(-1, j, k) + h.value(0, j, k));
+        BOOST_TEST_EQ(h0.value(2, j, k), h.value(3, j, k) + h.value(4, j, k));
+      }
+    }
+
+    auto h1 = h.slice(1, 1, 3);
+    BOOST_TEST(boost::get<regular_axis<>>(h1.axis(1)) ==
+               regular_axis<>(2, 1, 3, "", false));
+    BOOST_TEST_EQ(h1.value(2, 1, 0), h.value(2, 2, 0));
+
+    auto h2 = h.slice(2, 2, 3);
+    BOOST_TEST(boost::get<category_axis>(h2.axis(2)) == category_axis{"C"});
+    BOOST_TEST_EQ(h2.value(1, 3, 0), h.value(1, 3, 2));
+    BOOST_TEST_EQ(h2.sum(), h.project(2).value(2));
+
+    BOOST_TEST_THROWS(h.slice(3, 0, 1), std::out_of_range);
+    BOOST_TEST_THROWS(h.slice(0, 2, 1), std::out_of_range);
+  }
+
+  // slice keeps growth
+  {
+    auto h = make_dynamic_histogram(integer_axis(0, 3, "", false, true),
+                                    category_axis({"A", "B"}, "", false, true));
+    h.fill(0, std::string("A"));
+    auto h1 = h.slice(1, 1, 2);
+    h1.fill(5, std::string("C"));
+    BOOST_TEST(boost::get<category_axis>(h1.axis(1)) ==
+               category_axis({"B", "C"}, "", false, true));
+    BOOST_TEST_EQ(bins(h1.axis(0)), 6);
+    BOOST_TEST_EQ(h1.value(5, 1), 1);
+    BOOST_TEST_EQ(h1.sum(), 1);
+  }
+
+  // rebin keeps growth
+  {
+    auto h = make_dynamic_histogram(regular_axis<>(4, 0, 4, "", false, true));
+    h.fill(0.5);
+    auto h0 = h.rebin(0, 2);
+    h0.fill(5.0);
+    BOOST_TEST_EQ(bins(h0.axis(0)), 3);
+    BOOST_TEST_EQ(h0.sum(), 2);
+  }
+
+  // quantile
+  {
+    auto h = make_dynamic_histogram(variable_axis<>({0, 1, 2, 4}));
+    h.fill(0.5);
+    h.fill(1.5);
+    h.fill(3);
+    h.fill(3);
+    BOOST_TEST_EQ(quantile(h, 0.5), 2);
+    BOOST_TEST_EQ(quantile(h, 0.75), 3);
+    BOOST_TEST_EQ(quantile(h, 1), 4);
+    auto h2 = make_dynamic_histogram(integer_axis(0, 1), integer_axis(0, 1));
+    BOOST_TEST_THROWS(quantile(h2, 0.5), std::logic_error);
+  }
+
+  // reserved bins of category_axis are not visited
+  {
+    auto h = make_dynamic_histogram(category_axis({}, "", false, true));
+    for (const char *x : {"A", "B", "C", "D", "E", "E"}) {
+      h.fill(std::string(x));
+    }
+    BOOST_TEST_EQ(shape(h.axis()), 8);
+    BOOST_TEST_EQ(h.size(), 5u);
+    int n = 0;
+    h.for_each_bin([&n](const indexed_bin<double> &b) {
+      BOOST_TEST_EQ(b.idx(0), n);
+      ++n;
+    });
+    BOOST_TEST_EQ(n, 5);
+    n = 0;
+    for (const auto &b : indexed(h)) {
+      BOOST_TEST_EQ(b.idx(0), n);
+      ++n;
+    }
+    BOOST_TEST_EQ(n, 5);
+    BOOST_TEST_EQ(quantile(h, 0.5), 3);
+    BOOST_TEST_EQ(quantile(h, 1), 5);
+  }
+
+  // fill category_axis by name
+  {
+    auto h = make_dynamic_histogram(regular_axis<>(2, 0, 2),
+                                    category_axis({"A", "B"}, "", true));
+    h.fill(0.5, "B");
+    h.fill(1.5, std::string("Z"));
+    const std::string x = "A";
+    h.fill(0.5, x);
+    BOOST_TEST_EQ(h.value(0, 1), 1);
+    BOOST_TEST_EQ(h.value(1, 2), 1);
+    BOOST_TEST_EQ(h.value(0, 0), 1);
+    // a name passed for an axis that does not bin names is out of range
+    h.fill(x, x);
+    BOOST_TEST_EQ(h.sum(), 3);
+    h.add_marginal(1);
+    h.fill(x, x);
+    BOOST_TEST_EQ(h.sum(), 3);
+    BOOST_TEST_EQ(h.marginal(1).sum(), 3);
+  }
+
+  // growth
+  {
+    auto h = make_dynamic_histogram(integer_axis(0, 1, "", false, true),
+                                    regular_axis<>(2, 0, 2));
+    h.add_marginal(0);
+    h.fill(0, 0.5);
+    h.fill(-3, 0.5);
+    BOOST_TEST(boost::get<integer_axis>(h.axis(0)) ==
+               integer_axis(-3, 1, "", false, true));
+    BOOST_TEST_EQ(h.value(3, 0), 1);
+    BOOST_TEST_EQ(h.value(0, 0), 1);
+    std::vector<double> v = {6, 1.5};
+    h.fill(v.begin(), v.end());
+    BOOST_TEST_EQ(boost::get<integer_axis>(h.axis(0)).bins(), 10);
+    BOOST_TEST_EQ(h.value(9, 1), 1);
+    v = {-4, -1};
+    h.wfill(2, v.begin(), v.end());
+    BOOST_TEST_EQ(boost::get<integer_axis>(h.axis(0)).bins(), 13);
+    BOOST_TEST_EQ(h.value(2, -1), 2);
+    BOOST_TEST_EQ(h.value(12, 1), 1);
+    BOOST_TEST_EQ(h.value(6, 0), 1);
+    BOOST_TEST_EQ(h.sum(), 5);
+    BOOST_TEST(h.marginal(0) == h.project(0));
+  }
+
+  // masked_fill_n
+  {
+    auto h = make_dynamic_histogram(integer_axis(0, 1), regular_axis<>(2, 0, 2));
+    auto g = h;
+    const double v[] = {0, 0.5, 1, 1.5, 1, 0.5, 5, 0.5};
+    const bool m[] = {true, false, true, true};
+    const double w[] = {1, 2, 3, 4};
+    h.masked_fill_n(4, m, v);
+    BOOST_TEST_EQ(h.value(0, 0), 1);
+    BOOST_TEST_EQ(h.value(1, 1), 0);
+    BOOST_TEST_EQ(h.value(1, 0), 1);
+    BOOST_TEST_EQ(h.value(2, 0), 1);
+    BOOST_TEST_EQ(h.sum(), 3);
+    g.masked_wfill_n(4, m, w, v);
+    BOOST_TEST_EQ(g.value(1, 0), 3);
+    BOOST_TEST_EQ(g.value(2, 0), 4);
+    BOOST_TEST_EQ(g.sum(), 8);
+
+    // marginals and growth fall back to fill
+    h.add_marginal(0);
+    h.masked_fill_n(4, m, v);
+    BOOST_TEST_EQ(h.sum(), 6);
+    BOOST_TEST(h.marginal(0) == h.project(0));
+    auto e = make_dynamic_histogram(integer_axis(0, 1, "", false, true));
+    const int k[] = {0, 4, -2};
+    const bool n[] = {true, false, true};
+    e.masked_fill_n(3, n, k);
+    BOOST_TEST_EQ(e.sum(), 2);
+    BOOST_TEST_EQ(boost::get<integer_axis>(e.axis(0)).bins(), 4);
+  }
+
   // histogram_serialization
   {
     auto a = make_dynamic_histogram(
         regular_axis<>(3, -1, 1, "r"), circular_axis<>(4, 0.0, 1.0, "p"),
         variable_axis<>({0.1, 0.2, 0.3, 0.4, 0.5}, "v"),
-        category_axis{"A", "B", "C"}, integer_axis(0, 1, "i"));
-    a.fill(0.5, 0.1, 0.25, 1, 0);
+        category_axis{"A", "B", "C"}, integer_axis(0, 1, "i"),
+        category_axis({"GET", "POST"}, "c", true),
+        category_axis({}, "t", false, true));
+    a.fill(0.5, 0.1, 0.25, 1, 0, 1, std::string("x"));
     std::string buf;
     {
       std::ostringstream os;
@@ -500,6 +917,81 @@ int main() {
       ia >> b;
     }
     BOOST_TEST(a == b);
+    BOOST_TEST_EQ(boost::get<category_axis>(b.axis(5)).index("POST"), 1);
+    b.fill(0.5, 0.1, 0.25, 1, 0, 1, std::string("y"));
+    BOOST_TEST_EQ(b.value(2, 0, 1, 1, 0, 1, 0), 1);
+    BOOST_TEST_EQ(b.value(2, 0, 1, 1, 0, 1, 1), 1);
+  }
+
+  // histogram_serialization of an archive without growth flags
+  {
+    const std::string buf =
+        "22 serialization::archive 18 0 0 0 0 2 0 1 0\n"
+        "0 0 0 0 0 0 2 4 1 r 0.00000000000000000e+00 1.00000000000000000e+00\n"
+        "1 6 0 0 2 4 1 i 0 0 0 16 1 0 0 0 0 1 0 0 0 0 0 0 0 0 0 0 0";
+    auto a = make_dynamic_histogram(regular_axis<>(2, 0, 2, "r"),
+                                    integer_axis(0, 1, "i"));
+    a.fill(0.5, 1);
+    auto b = make_dynamic_histogram(integer_axis(0, 0, "", false, true));
+    {
+      std::istringstream is(buf);
+      boost::archive::text_iarchive ia(is);
+      ia >> b;
+    }
+    BOOST_TEST(a == b);
+    b.fill(5.0, 1);
+    BOOST_TEST_EQ(bins(b.axis(0)), 2);
+    BOOST_TEST_EQ(b.value(2, 1), 1);
+  }
+
+  // histogram_serialization of a category_axis without flags
+  {
+    const std::string buf = "22 serialization::archive 18 0 0 0 0 1 0 1 0\n"
+                            "0 7 0 0 0 0 2 0  1 A 1 B 0 0 2 1 0 1";
+    auto b = make_dynamic_histogram(category_axis({}, "", false, true));
+    {
+      std::istringstream is(buf);
+      boost::archive::text_iarchive ia(is);
+      ia >> b;
+    }
+    BOOST_TEST(boost::get<category_axis>(b.axis(0)) ==
+               category_axis({"A", "B"}));
+    BOOST_TEST_EQ(b.value(1), 1);
+    b.fill(std::string("C"));
+    BOOST_TEST_EQ(bins(b.axis(0)), 2);
+    BOOST_TEST_EQ(b.sum(), 1);
+  }
+
+  // histogram_serialization into a histogram with a marginal
+  {
+    auto a = make_dynamic_histogram(regular_axis<>(3, -1, 1),
+                                    integer_axis(0, 3));
+    a.fill(0.5, 3);
+    std::string buf;
+    {
+      std::ostringstream os;
+      boost::archive::text_oarchive oa(os);
+      oa << a;
+      buf = os.str();
+    }
+    auto b = make_dynamic_histogram(integer_axis(0, 0));
+    b.add_marginal(0);
+    b.fill(0);
+    {
+      std::istringstream is(buf);
+      boost::archive::text_iarchive ia(is);
+      ia >> b;
+    }
+    BOOST_TEST(a == b);
+    BOOST_TEST_THROWS(b.marginal(0), std::logic_error);
+    b.fill(-0.5, 3);
+    b.fill(0.5, 0);
+    BOOST_TEST_EQ(b.value(2, 3), 1);
+    BOOST_TEST_EQ(b.value(0, 3), 1);
+    BOOST_TEST_EQ(b.sum(), 3);
+    const summed_area_table t(b);
+    BOOST_TEST_EQ(t.integral(0, 3, 3, 4), 2);
+    BOOST_TEST_EQ(t.integral(-1, -1, 4, 5), 3);
   }
 
   // histogram_ostream
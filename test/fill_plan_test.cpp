@@ -0,0 +1,115 @@
+// Copyright 2015-2017 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/core/lightweight_test.hpp>
+#include <boost/histogram/fill_plan.hpp>
+#include <boost/histogram/histogram.hpp>
+#include <boost/histogram/storage/adaptive_storage.hpp>
+#include <stdexcept>
+#include <vector>
+
+int main() {
+  using namespace boost::histogram;
+  using dynamic_histogram = histogram<Dynamic, default_axes>;
+
+  // add
+  {
+    auto a = make_dynamic_histogram(regular_axis<>(4, 0, 1));
+    auto b = make_dynamic_histogram(regular_axis<>(4, 0, 1),
+                                    integer_axis(0, 3));
+    auto c = make_dynamic_histogram(regular_axis<>(4, 0, 1),
+                                    regular_axis<>(4, 0, 1));
+    fill_plan<dynamic_histogram> plan;
+    plan.add(a, {0});
+    plan.add(b, {0, 2});
+    plan.add(c, {1, 0});
+    BOOST_TEST_EQ(plan.size(), 3);
+    // the regular_axis on column 0 is computed once
+    BOOST_TEST_EQ(plan.slots(), 3);
+    BOOST_TEST_THROWS(plan.add(a, {0, 1}), std::logic_error);
+    const std::vector<unsigned> cols = {1};
+    plan.add(a, cols.begin(), cols.end()); // same as the first axis of c
+    BOOST_TEST_EQ(plan.slots(), 3);
+  }
+
+  // fill
+  {
+    auto a = make_dynamic_histogram(regular_axis<>(4, 0, 1));
+    auto b = make_dynamic_histogram(regular_axis<>(4, 0, 1),
+                                    integer_axis(0, 3, "", false));
+    auto c = make_dynamic_histogram(regular_axis<>(2, 0, 1),
+                                    regular_axis<>(4, 0, 1));
+    auto a2 = a, b2 = b, c2 = c;
+    fill_plan<dynamic_histogram> plan;
+    plan.add(a, {0});
+    plan.add(b, {0, 2});
+    plan.add(c, {1, 0});
+    const std::vector<std::vector<double>> records = {
+        {0.1, 0.2, 1}, {0.5, 0.7, 3}, {-1, 2, 0}, {0.9, 0.1, 7}};
+    for (const auto &r : records) {
+      plan.fill(r.begin());
+      a2.fill(r[0]);
+      b2.fill(r[0], r[2]);
+      c2.fill(r[1], r[0]);
+    }
+    BOOST_TEST(a == a2);
+    BOOST_TEST(b == b2);
+    BOOST_TEST(c == c2);
+    BOOST_TEST_EQ(b.sum(), 3);
+  }
+
+  // fill_n
+  {
+    auto a = make_dynamic_histogram(regular_axis<>(4, 0, 1));
+    auto b = make_dynamic_histogram(regular_axis<>(4, 0, 1),
+                                    category_axis{"A", "B"});
+    auto a2 = a, b2 = b;
+    fill_plan<dynamic_histogram> plan;
+    plan.add(a, {1});
+    plan.add(b, {1, 0});
+    const double x[] = {0.1, 0.4, 0.4, 1.5};
+    const double k[] = {0, 1, 1, 2};
+    const double *columns[] = {k, x};
+    plan.fill_n(4, columns);
+    for (unsigned i = 0; i < 4; ++i) {
+      a2.fill(x[i]);
+      b2.fill(x[i], k[i]);
+    }
+    BOOST_TEST(a == a2);
+    BOOST_TEST(b == b2);
+    BOOST_TEST_EQ(b.value(1, 1), 2);
+  }
+
+  // growth and marginals
+  {
+    auto a = make_dynamic_histogram(regular_axis<>(2, 0, 1, "", false, true));
+    auto b = make_dynamic_histogram(regular_axis<>(2, 0, 1, "", false, true));
+    auto c = make_dynamic_histogram(regular_axis<>(2, 0, 1),
+                                    integer_axis(0, 1));
+    c.add_marginal(1);
+    auto a2 = a, c2 = c;
+    fill_plan<dynamic_histogram> plan;
+    plan.add(a, {0});
+    plan.add(b, {0});
+    plan.add(c, {0, 1});
+    // growable axes are not shared
+    BOOST_TEST_EQ(plan.slots(), 4);
+    const std::vector<std::vector<double>> records = {
+        {0.25, 1}, {1.75, 0}, {-0.25, 1}, {0.75, 0}};
+    for (const auto &r : records) {
+      plan.fill(r.begin());
+      a2.fill(r[0]);
+      c2.fill(r[0], r[1]);
+    }
+    BOOST_TEST(a == a2);
+    BOOST_TEST(b == a2);
+    BOOST_TEST(c == c2);
+    BOOST_TEST(c.marginal(1) == c.project(1));
+    BOOST_TEST_EQ(c.marginal(1).value(0), 2);
+  }
+
+  return boost::report_errors();
+}
@@ -0,0 +1,163 @@
+// Copyright 2015-2017 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/archive/text_iarchive.hpp>
+#include <boost/archive/text_oarchive.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/histogram/histogram.hpp>
+#include <boost/histogram/histogram_bank.hpp>
+#include <boost/histogram/serialization.hpp>
+#include <boost/histogram/storage/adaptive_storage.hpp>
+#include <boost/histogram/storage/container_storage.hpp>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+int main() {
+  using namespace boost::histogram;
+
+  // init
+  {
+    auto b = histogram_bank<>(3, regular_axis<>(2, 0, 1), integer_axis(0, 1));
+    BOOST_TEST_EQ(b.channels(), 3);
+    BOOST_TEST_EQ(b.dim(), 2);
+    BOOST_TEST_EQ(b.field_count(), 4 * 4);
+    BOOST_TEST_EQ(b.size(), 3 * 4 * 4);
+    using axis_type = histogram_bank<>::axis_type;
+    BOOST_TEST(b.axis(0) == axis_type(regular_axis<>(2, 0, 1)));
+    BOOST_TEST(b.axis(1) == axis_type(integer_axis(0, 1)));
+    BOOST_TEST_THROWS(b.axis(2), std::out_of_range);
+    BOOST_TEST_THROWS(histogram_bank<>(0, integer_axis(0, 1)),
+                      std::logic_error);
+
+    std::vector<histogram_bank<>::axis_type> axes = {regular_axis<>(2, 0, 1),
+                                                     integer_axis(0, 1)};
+    auto b2 = histogram_bank<>(3, axes.begin(), axes.end());
+    BOOST_TEST(b2 == b);
+    BOOST_TEST(histogram_bank<>(2, axes.begin(), axes.end()) != b);
+
+    auto b3 = histogram_bank<>();
+    BOOST_TEST_EQ(b3.channels(), 0);
+    BOOST_TEST_EQ(b3.dim(), 0);
+  }
+
+  // fill and view
+  {
+    auto b = histogram_bank<>(3, integer_axis(0, 1));
+    b.fill(0, 0);
+    b.fill(2, 1);
+    b.fill(2, 1);
+    b.fill(2, 5);
+    b.wfill(1, 2.5, 0);
+    b.fill(3, 0); // channel out of range, dropped
+    BOOST_TEST_EQ(b.view(0).value(0), 1);
+    BOOST_TEST_EQ(b.view(0).value(1), 0);
+    BOOST_TEST_EQ(b.view(0).sum(), 1);
+    BOOST_TEST_EQ(b.view(1).value(0), 2.5);
+    BOOST_TEST_EQ(b.view(1).variance(0), 6.25);
+    BOOST_TEST_EQ(b.view(2).value(1), 2);
+    BOOST_TEST_EQ(b.view(2).value(2), 1);
+    BOOST_TEST_EQ(b.view(2).sum(), 3);
+    BOOST_TEST_THROWS(b.view(3), std::out_of_range);
+    BOOST_TEST_THROWS(b.view(0).value(4), std::out_of_range);
+  }
+
+  // channel
+  {
+    auto b = histogram_bank<>(2, regular_axis<>(2, 0, 2), integer_axis(0, 1));
+    auto h = make_dynamic_histogram(regular_axis<>(2, 0, 2), integer_axis(0, 1));
+    b.fill(0, 0.5, 1);
+    b.fill(1, 1.5, 0);
+    b.wfill(1, 2, -1.0, 1);
+    h.fill(1.5, 0);
+    h.wfill(2, -1.0, 1);
+    BOOST_TEST(b.channel(1) == h);
+    BOOST_TEST_EQ(b.channel(1).variance(-1, 1), 4);
+    BOOST_TEST_EQ(b.channel(0).sum(), 1);
+    BOOST_TEST_THROWS(b.channel(2), std::out_of_range);
+  }
+
+  // fill_n
+  {
+    auto a = histogram_bank<>(4, regular_axis<>(4, 0, 1));
+    auto b = a;
+    const unsigned c[] = {0, 3, 3, 1, 2, 0, 7};
+    const double x[] = {0.1, 0.2, 0.3, 0.4, 0.5, 2.0, 0.5};
+    a.fill_n(7, c, x);
+    for (unsigned i = 0; i < 7; ++i) {
+      b.fill(c[i], x[i]);
+    }
+    BOOST_TEST(a == b);
+    BOOST_TEST_EQ(a.view(0).sum(), 2);
+    BOOST_TEST_EQ(a.view(0).value(4), 1);
+    BOOST_TEST_EQ(a.view(3).value(0), 1);
+    BOOST_TEST_EQ(a.view(3).value(1), 1);
+  }
+
+  // growth
+  {
+    auto b = histogram_bank<>(2, regular_axis<>(2, 0, 1, "", false, true));
+    b.fill(1, 0.25);
+    b.fill(0, -0.25);
+    b.fill(1, 1.75);
+    BOOST_TEST(boost::get<regular_axis<>>(b.axis(0)) ==
+               regular_axis<>(5, -0.5, 2.0, "", false, true));
+    BOOST_TEST_EQ(b.view(0).value(0), 1);
+    BOOST_TEST_EQ(b.view(1).value(1), 1);
+    BOOST_TEST_EQ(b.view(1).value(4), 1);
+    BOOST_TEST_EQ(b.view(1).sum(), 2);
+  }
+
+  // operator+=
+  {
+    auto a = histogram_bank<>(2, integer_axis(0, 1));
+    auto b = a;
+    a.fill(0, 0);
+    b.fill(0, 0);
+    b.fill(1, 1);
+    a += b;
+    BOOST_TEST_EQ(a.view(0).value(0), 2);
+    BOOST_TEST_EQ(a.view(1).value(1), 1);
+    BOOST_TEST_THROWS(a += histogram_bank<>(3, integer_axis(0, 1)),
+                      std::logic_error);
+  }
+
+  // container_storage
+  {
+    auto b = histogram_bank<default_axes, container_storage<std::vector<int>>>(
+        2, integer_axis(0, 1));
+    b.fill(1, 1);
+    BOOST_TEST_EQ(b.view(1).value(1), 1);
+    BOOST_TEST_EQ(b.channel(1).value(1), 1);
+  }
+
+  // serialization
+  {
+    auto a = histogram_bank<>(3, regular_axis<>(3, -1, 1, "r"),
+                              category_axis{"A", "B"});
+    a.fill(2, 0.5, 1);
+    a.wfill(0, 1.5, -0.5, 0);
+    std::string buf;
+    {
+      std::ostringstream os;
+      boost::archive::text_oarchive oa(os);
+      oa << a;
+      buf = os.str();
+    }
+    auto b = histogram_bank<>();
+    BOOST_TEST(a != b);
+    {
+      std::istringstream is(buf);
+      boost::archive::text_iarchive ia(is);
+      ia >> b;
+    }
+    BOOST_TEST(a == b);
+    BOOST_TEST_EQ(b.channels(), 3);
+  }
+
+  return boost::report_errors();
+}
@@ -0,0 +1,156 @@
+// Copyright 2015-2017 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <array>
+#include <boost/archive/text_iarchive.hpp>
+#include <boost/archive/text_oarchive.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/histogram/histogram.hpp>
+#include <boost/histogram/serialization.hpp>
+#include <boost/histogram/storage/multi_weight_storage.hpp>
+#include <boost/histogram/utility.hpp>
+#include <sstream>
+#include <vector>
+
+int main() {
+  using namespace boost::histogram;
+
+  // ctor
+  {
+    multi_weight_storage<3> a(2);
+    BOOST_TEST_EQ(a.size(), 2u);
+    BOOST_TEST_EQ(a.weights(), 3u);
+    BOOST_TEST_EQ(a.value(1, 2), 0);
+    multi_weight_storage<3> b;
+    BOOST_TEST_EQ(b.size(), 0u);
+  }
+
+  // increase
+  {
+    multi_weight_storage<3> a(2);
+    const double w[] = {1, 2, 3};
+    a.increase(0, weight_span(w, 3));
+    a.increase(0, weight_span(w, 3));
+    a.increase(1);
+    a.increase(1, 2);
+    BOOST_TEST_EQ(a.value(0), 2);
+    BOOST_TEST_EQ(a.value(0, 1), 4);
+    BOOST_TEST_EQ(a.value(0, 2), 6);
+    BOOST_TEST_EQ(a.variance(0, 2), 18);
+    BOOST_TEST_EQ(a.value(1, 2), 3);
+    BOOST_TEST_EQ(a.variance(1, 0), 5);
+    BOOST_TEST_THROWS(a.increase(0, weight_span(w, 2)), std::logic_error);
+  }
+
+  // without squares
+  {
+    multi_weight_storage<2, false> a(1);
+    const std::vector<double> w = {2, 3};
+    a.increase(0, w);
+    BOOST_TEST_EQ(a.value(0, 1), 3);
+    BOOST_TEST(!detail::has_variance<decltype(a)>::value);
+    BOOST_TEST(detail::has_variance<multi_weight_storage<2>>::value);
+
+    auto h = make_static_histogram_with<multi_weight_storage<2, false>>(
+        integer_axis(0, 1));
+    h.wfill(w, 1);
+    h.wfill(w, 1);
+    BOOST_TEST_EQ(h.wvalue(1, 1), 6);
+    BOOST_TEST_EQ(h.project<0>().value(1), 4);
+  }
+
+  // merge and compare
+  {
+    multi_weight_storage<2> a(2), b(2), c(2);
+    const std::array<double, 2> w = {{1, 2}};
+    a.increase(0, w);
+    b.increase(1, w);
+    c.increase(0, w);
+    c.increase(1, w);
+    BOOST_TEST(!(a == b));
+    a += b;
+    BOOST_TEST(a == c);
+  }
+
+  // static histogram
+  {
+    auto h = make_static_histogram_with<multi_weight_storage<3>>(
+        integer_axis(0, 1), regular_axis<>(2, 0, 1));
+    const std::vector<double> w = {1, 0.5, 2};
+    h.wfill(w, 0, 0.2);
+    h.wfill(w, 0, 0.3);
+    h.wfill(w, 1, 2.0);
+    h.wfill(2, 1, 0.7);
+    BOOST_TEST_EQ(h.value(0, 0), 2);
+    BOOST_TEST_EQ(h.wvalue(1, 0, 0), 1);
+    BOOST_TEST_EQ(h.wvalue(2, 0, 0), 4);
+    BOOST_TEST_EQ(h.wvariance(2, 0, 0), 8);
+    BOOST_TEST_EQ(h.wvalue(1, 1, 2), 0.5);
+    BOOST_TEST_EQ(h.wvariance(1, 1, 1), 4);
+    BOOST_TEST_THROWS(h.wvalue(0, 3, 0), std::out_of_range);
+
+    const auto p = h.project<1>();
+    BOOST_TEST_EQ(p.wvalue(2, 0), 4);
+    BOOST_TEST_EQ(p.wvalue(1, 2), 0.5);
+  }
+
+  // dynamic histogram
+  {
+    auto h = make_dynamic_histogram_with<multi_weight_storage<2>>(
+        integer_axis(0, 1), integer_axis(0, 2));
+    const double w[] = {3, 4};
+    h.wfill(weight_span(w, 2), 0, 1);
+    h.fill(0, 1);
+    BOOST_TEST_EQ(h.wvalue(0, 0, 1), 4);
+    BOOST_TEST_EQ(h.wvalue(1, 0, 1), 5);
+    BOOST_TEST_EQ(h.wvariance(1, 0, 1), 17);
+
+    h.add_marginal(1);
+    h.wfill(weight_span(w, 2), 1, 1);
+    BOOST_TEST(h.marginal(1) == h.project(1));
+    BOOST_TEST_EQ(h.marginal(1).wvalue(1, 1), 9);
+
+    auto h2 = h;
+    h2 += h;
+    BOOST_TEST_EQ(h2.wvalue(1, 1, 1), 8);
+  }
+
+  // growth
+  {
+    auto h = make_dynamic_histogram_with<multi_weight_storage<2>>(
+        integer_axis(0, 1, "", false, true));
+    const double w[] = {1, 2};
+    h.wfill(weight_span(w, 2), 0);
+    h.wfill(weight_span(w, 2), -2);
+    BOOST_TEST_EQ(h.wvalue(1, 0), 2);
+    BOOST_TEST_EQ(h.wvalue(1, 2), 2);
+  }
+
+  // serialization
+  {
+    auto a = make_dynamic_histogram_with<multi_weight_storage<2>>(
+        integer_axis(0, 2));
+    const double w[] = {1.5, 2.5};
+    a.wfill(weight_span(w, 2), 1);
+    std::string buf;
+    {
+      std::ostringstream os;
+      boost::archive::text_oarchive oa(os);
+      oa << a;
+      buf = os.str();
+    }
+    decltype(a) b;
+    {
+      std::istringstream is(buf);
+      boost::archive::text_iarchive ia(is);
+      ia >> b;
+    }
+    BOOST_TEST(a == b);
+    BOOST_TEST_EQ(b.wvalue(1, 1), 2.5);
+  }
+
+  return boost::report_errors();
+}
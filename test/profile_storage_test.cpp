@@ -0,0 +1,211 @@
+// Copyright 2015-2017 Hans Dembinski
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <boost/archive/text_iarchive.hpp>
+#include <boost/archive/text_oarchive.hpp>
+#include <boost/core/lightweight_test.hpp>
+#include <boost/histogram/histogram.hpp>
+#include <boost/histogram/serialization.hpp>
+#include <boost/histogram/storage/profile_storage.hpp>
+#include <boost/histogram/utility.hpp>
+#include <sstream>
+#include <vector>
+
+int main() {
+  using namespace boost::histogram;
+
+  // ctor
+  {
+    profile_storage a(2);
+    BOOST_TEST_EQ(a.size(), 2u);
+    BOOST_TEST_EQ(a.value(0), 0);
+    BOOST_TEST_EQ(a.variance(1), 0);
+    profile_storage b;
+    BOOST_TEST_EQ(b.size(), 0u);
+  }
+
+  // sample
+  {
+    profile_storage a(2);
+    a.sample(0, 1);
+    a.sample(0, 3);
+    a.sample(1, 2, 2);
+    a.sample(1, 5);
+    BOOST_TEST_EQ(a.value(0), 2);
+    BOOST_TEST_EQ(a.variance(0), 2);
+    BOOST_TEST_EQ(a.mean(0), 2);
+    BOOST_TEST_EQ(a.sample_variance(0), 1);
+    BOOST_TEST_EQ(a.value(1), 3);
+    BOOST_TEST_EQ(a.variance(1), 5);
+    BOOST_TEST_EQ(a.mean(1), 3);
+    BOOST_TEST_EQ(a.sample_variance(1), 2);
+    a.increase(0);
+    a.increase(0, 2);
+    BOOST_TEST_EQ(a.value(0), 5);
+    BOOST_TEST_EQ(a.variance(0), 7);
+    BOOST_TEST_EQ(a.mean(0), 2);
+    BOOST_TEST_EQ(a.sample_variance(0), 1);
+    BOOST_TEST(a.mean(1) == a.mean(1));
+    BOOST_TEST(!(profile_storage(1).mean(0) == profile_storage(1).mean(0)));
+  }
+
+  // plain fills do not move the mean
+  {
+    auto h = make_static_histogram_with<profile_storage>(integer_axis(0, 1));
+    h.sfill(10, 0);
+    h.fill(0);
+    h.wfill(3, 0);
+    BOOST_TEST_EQ(h.value(0), 5);
+    BOOST_TEST_EQ(h.mean(0), 10);
+    BOOST_TEST_EQ(h.sample_variance(0), 0);
+  }
+
+  // variance of large samples
+  {
+    profile_storage a(2), b(2);
+    for (int i = 0; i < 1000; ++i) {
+      a.sample(0, 1e9 + 0.1 * (i % 3));
+      a.sample(i % 2, 1e9 + 0.1 * (i % 3));
+    }
+    b.add(0, a.bin(1));
+    b.add(0, a.bin(0));
+    for (std::size_t i = 0; i < 2; ++i) {
+      BOOST_TEST_GT(a.sample_variance(i), 0.0066);
+      BOOST_TEST_LT(a.sample_variance(i), 0.0067);
+    }
+    BOOST_TEST_EQ(b.value(0), 2000);
+    BOOST_TEST_GT(b.sample_variance(0), 0.0066);
+    BOOST_TEST_LT(b.sample_variance(0), 0.0067);
+  }
+
+  // sample_n
+  {
+    profile_storage a(3), b(3);
+    const std::size_t pos[] = {0, 2, 1, 2};
+    const int ok[] = {1, 1, 0, 1};
+    const double y[] = {1, 2, 1.0 / 0.0, 4};
+    a.sample_n(4, pos, ok, y);
+    b.sample(0, 1);
+    b.sample(2, 2);
+    b.sample(2, 4);
+    BOOST_TEST(a == b);
+  }
+
+  // merge and compare
+  {
+    profile_storage a(2), b(2), c(2);
+    a.sample(0, 1);
+    b.sample(0, 3);
+    c.sample(0, 1);
+    c.sample(0, 3);
+    BOOST_TEST(!(a == b));
+    a += b;
+    BOOST_TEST(a == c);
+    BOOST_TEST_EQ(a.mean(0), 2);
+    BOOST_TEST(!(a == profile_storage(3)));
+  }
+
+  // static histogram
+  {
+    auto h = make_static_histogram_with<profile_storage>(
+        integer_axis(0, 1), regular_axis<>(2, 0, 1));
+    h.sfill(1, 0, 0.2);
+    h.sfill(3, 0, 0.3);
+    h.wsfill(2, 4, 1, 0.7);
+    h.sfill(5, 1, 2.0); // overflow
+    BOOST_TEST_EQ(h.value(0, 0), 2);
+    BOOST_TEST_EQ(h.mean(0, 0), 2);
+    BOOST_TEST_EQ(h.sample_variance(0, 0), 1);
+    BOOST_TEST_EQ(h.value(1, 1), 2);
+    BOOST_TEST_EQ(h.variance(1, 1), 4);
+    BOOST_TEST_EQ(h.mean(1, 1), 4);
+    BOOST_TEST_EQ(h.mean(1, 2), 5);
+    BOOST_TEST_THROWS(h.mean(3, 0), std::out_of_range);
+
+    const auto p = h.project<0>();
+    BOOST_TEST_EQ(p.value(1), 3);
+    BOOST_TEST_EQ(p.mean(1), 13.0 / 3);
+  }
+
+  // static histogram sfill_n
+  {
+    auto a = make_static_histogram_with<profile_storage>(
+        regular_axis<>(4, 0, 1), regular_axis<>(3, -1, 1));
+    auto b = a;
+    std::vector<double> x, y, s;
+    for (int i = 0; i < 200; ++i) {
+      x.push_back(-0.1 + 0.006 * i);
+      y.push_back(-1.2 + 0.0121 * i);
+      s.push_back(i % 7);
+    }
+    a.sfill_n(x.size(), s.begin(), x.begin(), y.begin());
+    for (std::size_t i = 0; i < x.size(); ++i) {
+      b.sfill(s[i], x[i], y[i]);
+    }
+    BOOST_TEST(a == b);
+    BOOST_TEST_EQ(a.sum(), 200);
+  }
+
+  // dynamic histogram
+  {
+    auto h = make_dynamic_histogram_with<profile_storage>(integer_axis(0, 1),
+                                                          integer_axis(0, 2));
+    h.sfill(1, 0, 0);
+    h.sfill(3, 0, 0);
+    h.wsfill(2, 4, 1, 2);
+    BOOST_TEST_EQ(h.value(0, 0), 2);
+    BOOST_TEST_EQ(h.mean(0, 0), 2);
+    BOOST_TEST_EQ(h.sample_variance(0, 0), 1);
+    BOOST_TEST_EQ(h.mean(1, 2), 4);
+    BOOST_TEST_EQ(h.variance(1, 2), 4);
+    BOOST_TEST_THROWS(h.sample_variance(0, 4), std::out_of_range);
+
+    auto h2 = h;
+    h2 += h;
+    BOOST_TEST_EQ(h2.value(0, 0), 4);
+    BOOST_TEST_EQ(h2.mean(0, 0), 2);
+
+    h.add_marginal(1);
+    h.sfill(5, 1, 2);
+    BOOST_TEST(h.marginal(1) == h.project(1));
+    BOOST_TEST_EQ(h.marginal(1).value(2), 3);
+    BOOST_TEST_EQ(h.marginal(1).mean(2), 13.0 / 3);
+  }
+
+  // growth
+  {
+    auto h = make_dynamic_histogram_with<profile_storage>(
+        regular_axis<>(2, 0, 1, "", false, true));
+    h.sfill(1, 0.2);
+    h.sfill(3, 1.2);
+    BOOST_TEST_EQ(h.mean(2), 3);
+    BOOST_TEST_EQ(h.mean(0), 1);
+  }
+
+  // serialization
+  {
+    auto a = make_dynamic_histogram_with<profile_storage>(integer_axis(0, 2));
+    a.sfill(1.5, 1);
+    a.wsfill(2, 0.5, 2);
+    std::string buf;
+    {
+      std::ostringstream os;
+      boost::archive::text_oarchive oa(os);
+      oa << a;
+      buf = os.str();
+    }
+    decltype(a) b;
+    {
+      std::istringstream is(buf);
+      boost::archive::text_iarchive ia(is);
+      ia >> b;
+    }
+    BOOST_TEST(a == b);
+    BOOST_TEST_EQ(b.mean(1), 1.5);
+  }
+
+  return boost::report_errors();
+}
@@ -80,6 +80,37 @@ template <typename Histogram> double compare_3d(unsigned n, int distrib) {
   return best;
 }
 
+template <typename Histogram> double compare_2d_n(unsigned n, int distrib) {
+  auto r = random_array(n, distrib);
+
+  auto best = std::numeric_limits<double>::max();
+  for (unsigned k = 0; k < 50; ++k) {
+    auto h = Histogram(regular_axis<>(100, 0, 1), regular_axis<>(100, 0, 1));
+    auto t = clock();
+    h.fill_n(n/2, r.begin(), r.begin() + n/2);
+    t = clock() - t;
+    best = std::min(best, double(t) / CLOCKS_PER_SEC);
+  }
+
+  return best;
+}
+
+template <typename Histogram> double compare_3d_n(unsigned n, int distrib) {
+  auto r = random_array(n, distrib);
+
+  auto best = std::numeric_limits<double>::max();
+  for (unsigned k = 0; k < 50; ++k) {
+    auto h = Histogram(regular_axis<>(100, 0, 1), regular_axis<>(100, 0, 1),
+                       regular_axis<>(100, 0, 1));
+    auto t = clock();
+    h.fill_n(n/3, r.begin(), r.begin() + n/3, r.begin() + 2 * n/3);
+    t = clock() - t;
+    best = std::min(best, double(t) / CLOCKS_PER_SEC);
+  }
+
+  return best;
+}
+
 template <typename Histogram> double compare_6d(unsigned n, int distrib) {
   auto r = random_array(n, distrib);
 
@@ -103,6 +134,75 @@ template <typename Histogram> double compare_6d(unsigned n, int distrib) {
   return best;
 }
 
+template <typename Histogram> double compare_large_3d(unsigned n) {
+  auto r = random_array(n, 0);
+
+  auto best = std::numeric_limits<double>::max();
+  for (unsigned k = 0; k < 5; ++k) {
+    // 402^3 = 65M bins, far beyond the reach of the TLB with 4k pages
+    auto h = Histogram(regular_axis<>(400, 0, 1), regular_axis<>(400, 0, 1),
+                       regular_axis<>(400, 0, 1));
+    h.fill(0.5, 0.5, 0.5); // allocate buffer outside of the timed loop
+    auto t = clock();
+    for (unsigned i = 0; i < n/3; ++i)
+      h.fill(r[3 * i], r[3 * i + 1], r[3 * i + 2]);
+    t = clock() - t;
+    best = std::min(best, double(t) / CLOCKS_PER_SEC);
+  }
+
+  return best;
+}
+
+template <typename Histogram>
+double compare_large_3d_n(unsigned n, fill_mode mode) {
+  auto r = random_array(n, 0);
+
+  auto best = std::numeric_limits<double>::max();
+  for (unsigned k = 0; k < 5; ++k) {
+    auto h = Histogram(regular_axis<>(400, 0, 1), regular_axis<>(400, 0, 1),
+                       regular_axis<>(400, 0, 1));
+    h.fill(0.5, 0.5, 0.5); // allocate buffer outside of the timed loop
+    auto t = clock();
+    h.fill_n(mode, n/3, r.begin(), r.begin() + n/3, r.begin() + 2 * n/3);
+    t = clock() - t;
+    best = std::min(best, double(t) / CLOCKS_PER_SEC);
+  }
+
+  return best;
+}
+
+// n entries with K weights each, into K histograms or one with K sums per bin
+template <unsigned K> void compare_multi_weight(unsigned n) {
+  auto r = random_array(n, 0);
+  auto w = random_array(K * n/2, 1);
+  using axes = mpl::vector<regular_axis<>, regular_axis<>>;
+
+  auto best_k = std::numeric_limits<double>::max();
+  auto best_1 = std::numeric_limits<double>::max();
+  for (unsigned k = 0; k < 5; ++k) {
+    using single = histogram<Static, axes, container_storage<std::vector<double>>>;
+    std::vector<single> hs(
+        K, single(regular_axis<>(100, 0, 1), regular_axis<>(100, 0, 1)));
+    auto t = clock();
+    for (unsigned i = 0; i < n/2; ++i)
+      for (unsigned j = 0; j < K; ++j)
+        hs[j].wfill(w[K * i + j], r[2 * i], r[2 * i + 1]);
+    t = clock() - t;
+    best_k = std::min(best_k, double(t) / CLOCKS_PER_SEC);
+
+    auto h = histogram<Static, axes, multi_weight_storage<K>>(
+        regular_axis<>(100, 0, 1), regular_axis<>(100, 0, 1));
+    t = clock();
+    for (unsigned i = 0; i < n/2; ++i)
+      h.wfill(weight_span(&w[K * i], K), r[2 * i], r[2 * i + 1]);
+    t = clock() - t;
+    best_1 = std::min(best_1, double(t) / CLOCKS_PER_SEC);
+  }
+
+  printf("%u histograms      %.3f\n", K, best_k);
+  printf("multi_weight_storage %.3f\n", best_1);
+}
+
 int main() {
   printf("1D\n");
   for (int itype = 0; itype < 2; ++itype) {
@@ -147,6 +247,14 @@ int main() {
     printf("hd_sd %.3f\n",
            compare_2d<histogram<Dynamic, default_axes, adaptive_storage<>>>(
                6000000, itype));
+    printf("hs_ss fill_n %.3f\n",
+           compare_2d_n<histogram<Static,
+               mpl::vector<regular_axis<>, regular_axis<>>,
+               container_storage<std::vector<int>>>>(6000000, itype));
+    printf("hs_sd fill_n %.3f\n",
+           compare_2d_n<histogram<Static,
+               mpl::vector<regular_axis<>, regular_axis<>>,
+               adaptive_storage<>>>(6000000, itype));
   }
 
   printf("3D\n");
@@ -170,6 +278,14 @@ int main() {
     printf("hd_sd %.3f\n",
            compare_3d<histogram<Dynamic, default_axes, adaptive_storage<>>>(
                6000000, itype));
+    printf("hs_ss fill_n %.3f\n",
+           compare_3d_n<histogram<Static,
+               mpl::vector<regular_axis<>, regular_axis<>, regular_axis<>>,
+               container_storage<std::vector<int>>>>(6000000, itype));
+    printf("hs_sd fill_n %.3f\n",
+           compare_3d_n<histogram<Static,
+               mpl::vector<regular_axis<>, regular_axis<>, regular_axis<>>,
+               adaptive_storage<>>>(6000000, itype));
   }
 
   printf("6D\n");
@@ -196,4 +312,35 @@ int main() {
            compare_6d<histogram<Dynamic, default_axes, adaptive_storage<>>>(
                6000000, itype));
   }
+
+  printf("3D large, random fill\n");
+  using large_axes =
+      mpl::vector<regular_axis<>, regular_axis<>, regular_axis<>>;
+  printf("std::allocator                  %.3f\n",
+         compare_large_3d<histogram<Static, large_axes, adaptive_storage<>>>(
+             6000000));
+  printf("huge_page_allocator             %.3f\n",
+         compare_large_3d<histogram<Static, large_axes,
+                                    adaptive_storage<huge_page_allocator>>>(
+             6000000));
+  printf("interleaved_huge_page_allocator %.3f\n",
+         compare_large_3d<histogram<
+             Static, large_axes,
+             adaptive_storage<interleaved_huge_page_allocator>>>(6000000));
+  printf("first_touch_huge_page_allocator %.3f\n",
+         compare_large_3d<histogram<
+             Static, large_axes,
+             adaptive_storage<first_touch_huge_page_allocator>>>(6000000));
+
+  printf("3D large, fill_n\n");
+  using large_type = histogram<Static, large_axes, adaptive_storage<>>;
+  printf("direct     %.3f\n",
+         compare_large_3d_n<large_type>(6000000, fill_mode::direct));
+  printf("prefetched %.3f\n",
+         compare_large_3d_n<large_type>(6000000, fill_mode::prefetched));
+  printf("bucketed   %.3f\n",
+         compare_large_3d_n<large_type>(6000000, fill_mode::bucketed));
+
+  printf("2D, 100 weights per entry\n");
+  compare_multi_weight<100>(200000);
 }
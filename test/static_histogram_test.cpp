@@ -4,18 +4,22 @@
 // (See accompanying file LICENSE_1_0.txt
 // or copy at http://www.boost.org/LICENSE_1_0.txt)
 
+#include <algorithm>
 #include <boost/archive/text_iarchive.hpp>
 #include <boost/archive/text_oarchive.hpp>
 #include <boost/core/lightweight_test.hpp>
 #include <boost/histogram/axis_ostream_operators.hpp>
+#include <boost/histogram/bit_iterator.hpp>
 #include <boost/histogram/histogram.hpp>
 #include <boost/histogram/histogram_ostream_operators.hpp>
 #include <boost/histogram/serialization.hpp>
 #include <boost/histogram/storage/adaptive_storage.hpp>
 #include <boost/histogram/storage/container_storage.hpp>
+#include <boost/histogram/summed_area_table.hpp>
 #include <boost/histogram/utility.hpp>
 #include <limits>
 #include <sstream>
+#include <utility>
 #include <vector>
 
 int main() {
@@ -511,6 +515,813 @@ int main() {
     BOOST_TEST_EQ(os1.str(), os2.str());
   }
 
+  // bin_iterator
+  {
+    auto h = make_static_histogram(integer_axis(0, 1),
+                                   regular_axis<>(2, -1, 1, "", false));
+    h.fill(0, -1);
+    h.fill(1, 0.5);
+    h.fill(-1, 0.5);
+    h.wfill(3, 2, -0.5);
+
+    std::vector<std::pair<int, int>> idx;
+    double sum = 0;
+    for (const auto &b : indexed(h)) {
+      BOOST_TEST_EQ(b.dim(), 2);
+      BOOST_TEST_EQ(b.value, h.value(b.idx(0), b.idx(1)));
+      BOOST_TEST_EQ(b.variance, h.variance(b.idx(0), b.idx(1)));
+      idx.emplace_back(b.idx(0), b.idx(1));
+      sum += b.value;
+    }
+    BOOST_TEST_EQ(idx.size(), h.size());
+    BOOST_TEST_EQ(sum, h.sum());
+    BOOST_TEST(idx[0] == std::make_pair(0, 0));
+    BOOST_TEST(idx[2] == std::make_pair(2, 0));
+    BOOST_TEST(idx[3] == std::make_pair(-1, 0));
+    BOOST_TEST(idx[4] == std::make_pair(0, 1));
+    BOOST_TEST(idx[7] == std::make_pair(-1, 1));
+
+    // bins keep their indices when copied out of the range
+    auto it = indexed(h).begin();
+    const auto b0 = *it;
+    ++it;
+    BOOST_TEST_EQ(b0.idx(0), 0);
+    BOOST_TEST_EQ(it->idx(0), 1);
+    const auto r = indexed(h);
+    const std::vector<indexed_bin<double>> bins(r.begin(), r.end());
+    BOOST_TEST_EQ(bins.size(), h.size());
+    for (unsigned i = 0; i < bins.size(); ++i) {
+      BOOST_TEST(idx[i] == std::make_pair(bins[i].idx(0), bins[i].idx(1)));
+    }
+
+    unsigned n = 0;
+    h.for_each_bin([&](const indexed_bin<double> &b) {
+      BOOST_TEST(idx[n++] == std::make_pair(b.idx(0), b.idx(1)));
+      BOOST_TEST_EQ(b.value, h.value(b.idx(0), b.idx(1)));
+      BOOST_TEST_EQ(b.variance, h.variance(b.idx(0), b.idx(1)));
+    });
+    BOOST_TEST_EQ(n, h.size());
+
+    auto h2 = histogram<Static, mpl::vector<integer_axis, regular_axis<>>,
+                        container_storage<std::vector<int>>>(h);
+    n = 0;
+    h2.for_each_bin([&](const indexed_bin<int> &b) {
+      BOOST_TEST_EQ(b.value, h2.value(b.idx(0), b.idx(1)));
+      ++n;
+    });
+    BOOST_TEST_EQ(n, h2.size());
+  }
+
+  // project
+  {
+    auto h = make_static_histogram(integer_axis(0, 1), integer_axis(0, 2),
+                                   integer_axis(0, 3, "", false));
+    h.fill(0, 0, 0);
+    h.fill(0, 1, 1);
+    h.fill(1, 1, 2);
+    h.fill(1, 2, 2);
+    h.fill(-1, 3, 3);
+    h.wfill(2, 1, 0, 3);
+
+    auto h0 = h.project<0>();
+    BOOST_TEST_EQ(h0.dim(), 1);
+    BOOST_TEST(h0.axis<0>() == integer_axis(0, 1));
+    BOOST_TEST_EQ(h0.sum(), h.sum());
+    BOOST_TEST_EQ(h0.value(-1), 1);
+    BOOST_TEST_EQ(h0.value(0), 2);
+    BOOST_TEST_EQ(h0.value(1), 4);
+    BOOST_TEST_EQ(h0.variance(1), 6);
+    BOOST_TEST_EQ(h0.value(2), 0);
+
+    auto h21 = h.project<2, 1>();
+    BOOST_TEST_EQ(h21.dim(), 2);
+    BOOST_TEST(h21.axis<0>() == integer_axis(0, 3, "", false));
+    BOOST_TEST(h21.axis<1>() == integer_axis(0, 2));
+    BOOST_TEST_EQ(h21.sum(), h.sum());
+    for (int i = 0; i < 4; ++i) {
+      for (int j = -1; j < 4; ++j) {
+        double v = 0, var = 0;
+        for (int k = -1; k < 3; ++k) {
+          v += h.value(k, j, i);
+          var += h.variance(k, j, i);
+        }
+        BOOST_TEST_EQ(h21.value(i, j), v);
+        BOOST_TEST_EQ(h21.variance(i, j), var);
+      }
+    }
+
+    auto h2 = histogram<Static,
+                        mpl::vector<integer_axis, integer_axis, integer_axis>,
+                        container_storage<std::vector<int>>>(h).project<1>();
+    BOOST_TEST_EQ(h2.value(1), 2);
+    BOOST_TEST_EQ(h2.value(3), 1);
+  }
+
+  // project large
+  {
+    auto h = make_static_histogram(regular_axis<>(100, 0, 1),
+                                   regular_axis<>(100, 0, 1),
+                                   regular_axis<>(20, 0, 1));
+    for (int i = 0; i < 1000; ++i) {
+      h.fill(0.001 * i, 0.0013 * i, 0.0017 * i);
+    }
+    auto h1 = h.project<1>();
+    auto h02 = h.project<0, 2>();
+    BOOST_TEST_EQ(h1.sum(), 1000);
+    BOOST_TEST_EQ(h02.sum(), 1000);
+    for (int j = -1; j < 101; ++j) {
+      double v = 0;
+      for (int i = -1; i < 101; ++i) {
+        for (int k = -1; k < 21; ++k) {
+          v += h.value(i, j, k);
+        }
+      }
+      BOOST_TEST_EQ(h1.value(j), v);
+    }
+    double v = 0;
+    for (int j = -1; j < 101; ++j) {
+      v += h.value(10, j, 1);
+    }
+    BOOST_TEST_EQ(h02.value(10, 1), v);
+  }
+
+  // project counts above 2^53
+  {
+    auto h = make_static_histogram(integer_axis(0, 1), integer_axis(0, 1));
+    auto ref = make_static_histogram(integer_axis(0, 1));
+    h.fill(0, 0);
+    h.fill(0, 1);
+    ref.fill(0);
+    ref.fill(0);
+    for (int i = 0; i < 60; ++i) {
+      h += h;
+      ref += ref;
+    }
+    h.fill(0, 0);
+    ref.fill(0);
+    BOOST_TEST(h.project<0>() == ref);
+    BOOST_TEST(!(h.project<0>() == decltype(ref)(ref.axis<0>())));
+    BOOST_TEST(h.rebin<1>(2).project<0>() == ref);
+  }
+
+  // add_marginal
+  {
+    auto h = make_static_histogram(integer_axis(0, 1), integer_axis(0, 2),
+                                   integer_axis(0, 3, "", false));
+    h.fill(0, 0, 0);
+    h.add_marginal<0>();
+    h.add_marginal<2, 1>();
+    h.fill(0, 1, 1);
+    h.fill(1, 1, 2);
+    h.fill(1, 2, 2);
+    h.fill(-1, 3, 3);
+    h.fill(0, 0, 4); // dropped, no underflow/overflow on last axis
+    h.wfill(2, 1, 0, 3);
+
+    BOOST_TEST(h.marginal<0>() == h.project<0>());
+    BOOST_TEST((h.marginal<2, 1>() == h.project<2, 1>()));
+    BOOST_TEST_EQ(h.marginal<0>().value(1), 4);
+    BOOST_TEST_EQ(h.marginal<0>().variance(1), 6);
+    BOOST_TEST_THROWS(h.marginal<1>(), std::logic_error);
+
+    auto h2 = h;
+    h2 += h;
+    BOOST_TEST((h2.marginal<2, 1>() == h2.project<2, 1>()));
+    BOOST_TEST_EQ(h2.marginal<0>().value(1), 8);
+  }
+
+  // integral
+  {
+    auto h = make_static_histogram(integer_axis(0, 2), integer_axis(0, 3, "", false),
+                                   regular_axis<>(2, 0, 1));
+    for (int i = -1; i < 4; ++i) {
+      for (int j = 0; j < 4; ++j) {
+        for (int k = 0; k < 4; ++k) {
+          if ((i + 2 * j + k) % 3) {
+            h.wfill(1 + (i + j) % 2, i, j, 0.4 * k - 0.2);
+          }
+        }
+      }
+    }
+    auto brute = [&h](int i0, int j0, int k0, int i1, int j1, int k1) {
+      std::pair<double, double> s(0, 0);
+      for (int i = i0; i < i1; ++i) {
+        for (int j = j0; j < j1; ++j) {
+          for (int k = k0; k < k1; ++k) {
+            s.first += h.value(i, j, k);
+            s.second += h.variance(i, j, k);
+          }
+        }
+      }
+      return s;
+    };
+    summed_area_table t(h);
+    BOOST_TEST_EQ(t.dim(), 3u);
+    BOOST_TEST_EQ(t.integral(-1, 0, -1, 4, 4, 3), h.sum());
+    for (int i0 = -1; i0 < 4; ++i0) {
+      for (int i1 = i0; i1 < 5; ++i1) {
+        for (int j0 = 0; j0 < 4; ++j0) {
+          for (int k1 = -1; k1 < 4; ++k1) {
+            const auto s = brute(i0, j0, -1, i1, 4, k1);
+            BOOST_TEST_EQ(t.integral(i0, j0, -1, i1, 4, k1), s.first);
+            BOOST_TEST_EQ(t.integral_variance(i0, j0, -1, i1, 4, k1),
+                          s.second);
+          }
+        }
+      }
+    }
+
+    // changes of the histogram make the table stale
+    const double before = t.integral(1, 1, 1, 2, 2, 2);
+    BOOST_TEST(t.is_current());
+    h.fill(1, 1, 0.5);
+    BOOST_TEST(!t.is_current());
+    BOOST_TEST_THROWS(t.integral(1, 1, 1, 2, 2, 2), std::logic_error);
+    BOOST_TEST_THROWS(t.integral_variance(1, 1, 1, 2, 2, 2), std::logic_error);
+    t.rebuild(h);
+    BOOST_TEST_EQ(t.integral(1, 1, 1, 2, 2, 2), before + 1);
+    h.wfill(2, 5, 0, 0); // overflow
+    BOOST_TEST(!t.is_current());
+    t.rebuild(h);
+    auto h3 = h;
+    h += h3;
+    BOOST_TEST(!t.is_current());
+    t.rebuild(h);
+    h = h3;
+    BOOST_TEST(!t.is_current());
+    t.rebuild(h);
+    const int zero[] = {0};
+    const double half[] = {0.5};
+    h.fill_n(1, zero, zero, half);
+    BOOST_TEST(!t.is_current());
+    const summed_area_table t2(h);
+    BOOST_TEST_EQ(t2.integral(1, 1, 1, 2, 2, 2), before + 1);
+    BOOST_TEST_EQ(t2.integral(1, 1, 1, 2, 2, 2), h.value(1, 1, 1));
+    BOOST_TEST_EQ(t2.integral(0, 0, 0, 3, 4, 2), brute(0, 0, 0, 3, 4, 2).first);
+
+    BOOST_TEST_THROWS(t2.integral(-2, 0, 0, 1, 1, 1), std::out_of_range);
+    BOOST_TEST_THROWS(t2.integral(0, -1, 0, 1, 1, 1), std::out_of_range);
+    BOOST_TEST_THROWS(t2.integral(0, 0, 0, 1, 5, 1), std::out_of_range);
+    BOOST_TEST_THROWS(t2.integral(1, 0, 0, 0, 1, 1), std::out_of_range);
+  }
+
+  // rebin
+  {
+    auto h = make_static_histogram(regular_axis<>(6, 0, 6), integer_axis(0, 4));
+    for (int i = -1; i < 8; ++i) {
+      for (int j = -1; j < 6; ++j) {
+        h.wfill(1 + (i + j) % 3, i + 0.5, j);
+      }
+    }
+
+    auto h0 = h.rebin<0>(2);
+    BOOST_TEST(h0.axis<0>() == regular_axis<>(3, 0, 6));
+    BOOST_TEST(h0.axis<1>() == h.axis<1>());
+    BOOST_TEST_EQ(h0.sum(), h.sum());
+    for (int j = -1; j < 6; ++j) {
+      for (int i = 0; i < 3; ++i) {
+        BOOST_TEST_EQ(h0.value(i, j), h.value(2 * i, j) + h.value(2 * i + 1, j));
+        BOOST_TEST_EQ(h0.variance(i, j),
+                      h.variance(2 * i, j) + h.variance(2 * i + 1, j));
+      }
+      BOOST_TEST_EQ(h0.value(-1, j), h.value(-1, j));
+      BOOST_TEST_EQ(h0.value(3, j), h.value(6, j));
+    }
+
+    // left over bins go into the overflow bin
+    auto h1 = h.rebin<0>(4);
+    BOOST_TEST(h1.axis<0>() == regular_axis<>(1, 0, 4));
+    BOOST_TEST_EQ(h1.sum(), h.sum());
+    BOOST_TEST_EQ(h1.value(1, 0), h.value(4, 0) + h.value(5, 0) + h.value(6, 0));
+
+    // merged integers become a regular axis
+    auto h2 = h.rebin<1>(2);
+    BOOST_TEST(h2.axis<1>() == regular_axis<>(2, 0, 4));
+    BOOST_TEST_EQ(h2.value(0, 1), h.value(0, 2) + h.value(0, 3));
+    BOOST_TEST_EQ(h2.value(0, 2), h.value(0, 4) + h.value(0, 5));
+    BOOST_TEST_EQ(h2.axis<1>().index(3), 1);
+    BOOST_TEST_EQ(h2.axis<1>().index(4), 2);
+
+    auto h3 = make_static_histogram(variable_axis<>({0, 1, 3, 4, 8}, "", false));
+    h3.fill(0.5);
+    h3.fill(2);
+    h3.fill(5);
+    auto h4 = h3.rebin<0>(3);
+    BOOST_TEST(h4.axis<0>() == variable_axis<>({0, 4}, "", false));
+    BOOST_TEST_EQ(h4.sum(), 2);
+
+    BOOST_TEST_THROWS(h.rebin<0>(0), std::logic_error);
+    BOOST_TEST_THROWS(h.rebin<0>(7), std::logic_error);
+  }
+
+  // slice
+  {
+    auto h = make_static_histogram(regular_axis<>(6, 0, 6), integer_axis(0, 4),
+                                   integer_axis(0, 2, "", false));
+    for (int i = -1; i < 8; ++i) {
+      for (int j = -1; j < 6; ++j) {
+        h.wfill(1 + (i + j) % 3, i + 0.5, j, (i + 3) % 3);
+      }
+    }
+
+    auto h0 = h.slice<0>(2, 5);
+    BOOST_TEST(h0.axis<0>() == regular_axis<>(3, 2, 5));
+    BOOST_TEST(h0.axis<1>() == h.axis<1>());
+    BOOST_TEST_EQ(h0.sum(), h.sum());
+    for (int j = -1; j < 6; ++j) {
+      for (int k = 0; k < 3; ++k) {
+        for (int i = 0; i < 3; ++i) {
+          BOOST_TEST_EQ(h0.value(i, j, k), h.value(i + 2, j, k));
+          BOOST_TEST_EQ(h0.variance(i, j, k), h.variance(i + 2, j, k));
+        }
+        BOOST_TEST_EQ(h0.value(-1, j, k),
+                      h.value(-1, j, k) + h.value(0, j, k) + h.value(1, j, k));
+        BOOST_TEST_EQ(h0.value(3, j, k), h.value(5, j, k) + h.value(6, j, k));
+      }
+    }
+
+    auto h1 = h.slice<1>(1, 2);
+    BOOST_TEST(h1.axis<1>() == integer_axis(1, 1));
+    BOOST_TEST_EQ(h1.sum(), h.sum());
+    BOOST_TEST_EQ(h1.value(0, 0, 1), h.value(0, 1, 1));
+
+    // cut off bins are dropped without underflow/overflow
+    auto h2 = h.slice<2>(1, 3);
+    BOOST_TEST(h2.axis<2>() == integer_axis(1, 2, "", false));
+    BOOST_TEST_EQ(h2.value(0, 0, 0), h.value(0, 0, 1));
+    BOOST_TEST_EQ(h2.sum(), h.sum() - h.project<2>().value(0));
+
+    BOOST_TEST_THROWS(h.slice<0>(3, 3), std::out_of_range);
+    BOOST_TEST_THROWS(h.slice<0>(-1, 3), std::out_of_range);
+    BOOST_TEST_THROWS(h.slice<0>(0, 7), std::out_of_range);
+  }
+
+  // slice keeps growth
+  {
+    auto h = make_static_histogram(regular_axis<>(4, 0, 4, "", false, true),
+                                   integer_axis(0, 3, "", false, true),
+                                   category_axis({"A", "B"}, "", false, true));
+    h.fill(0.5, 0, "A");
+    auto h0 = h.slice<0>(1, 3);
+    BOOST_TEST(h0.axis<0>() == regular_axis<>(2, 1, 3, "", false, true));
+    auto h1 = h.slice<1>(0, 2);
+    BOOST_TEST(h1.axis<1>() == integer_axis(0, 1, "", false, true));
+    h1.fill(0.5, 3, "A");
+    BOOST_TEST_EQ(h1.axis<1>().bins(), 4);
+    BOOST_TEST_EQ(h1.value(0, 3, 0), 1);
+    BOOST_TEST_EQ(h1.sum(), 2);
+    auto h2 = h.slice<2>(1, 2);
+    BOOST_TEST(h2.axis<2>() == category_axis({"B"}, "", false, true));
+    h2.fill(0.5, 0, "C");
+    BOOST_TEST_EQ(h2.axis<2>().bins(), 2);
+    BOOST_TEST_EQ(h2.value(0, 0, 1), 1);
+    BOOST_TEST_EQ(h2.sum(), 1);
+  }
+
+  // rebin keeps growth
+  {
+    auto h = make_static_histogram(regular_axis<>(4, 0, 4, "", false, true),
+                                   integer_axis(0, 3, "", false, true));
+    h.fill(0.5, 0);
+    auto h0 = h.rebin<0>(2);
+    BOOST_TEST(h0.axis<0>().growth());
+    h0.fill(5.0, 0);
+    BOOST_TEST_EQ(h0.axis<0>().bins(), 3);
+    BOOST_TEST_EQ(h0.sum(), 2);
+    auto h1 = h.rebin<1>(2);
+    BOOST_TEST(h1.axis<1>() == regular_axis<>(2, 0, 4, "", false, true));
+  }
+
+  // fill category_axis by name
+  {
+    auto h = make_static_histogram(category_axis({"A", "B", "C"}, "", true),
+                                   integer_axis(0, 1, "", false));
+    h.fill("B", 0);
+    h.fill(std::string("C"), 1);
+    h.fill("X", 1);
+    h.fill(1, 1);
+    BOOST_TEST_EQ(h.size(), 8u);
+    BOOST_TEST_EQ(h.value(1, 0), 1);
+    BOOST_TEST_EQ(h.value(2, 1), 1);
+    BOOST_TEST_EQ(h.value(3, 1), 1);
+    BOOST_TEST_EQ(h.value(1, 1), 1);
+    BOOST_TEST_THROWS(h.value(4, 1), std::out_of_range);
+    BOOST_TEST_THROWS(h.value(-1, 1), std::out_of_range);
+    const summed_area_table t(h);
+    BOOST_TEST_EQ(t.integral(0, 0, 4, 2), 4);
+    BOOST_TEST_EQ(t.integral(3, 0, 4, 2), 1);
+    BOOST_TEST_EQ(h.project<0>().value(3), 1);
+
+    // cut off categories are counted as unknown
+    auto h1 = h.slice<0>(2, 3);
+    BOOST_TEST(h1.axis<0>() == category_axis({"C"}, "", true));
+    BOOST_TEST_EQ(h1.value(0, 1), 1);
+    BOOST_TEST_EQ(h1.value(1, 0), 1);
+    BOOST_TEST_EQ(h1.value(1, 1), 2);
+
+    auto h2 = make_static_histogram(category_axis({"A", "B"}));
+    h2.fill("X");
+    h2.fill("A");
+    BOOST_TEST_EQ(h2.sum(), 1);
+  }
+
+  // transform_axis
+  {
+    using log_axis = transform_axis<transform::log>;
+    auto h = make_static_histogram(log_axis(4, 1, 1e4), integer_axis(0, 1));
+    for (double x = 0.5; x < 2e4; x *= 2) {
+      h.fill(x, 0);
+    }
+    BOOST_TEST_EQ(h.value(-1, 0), 1);
+    BOOST_TEST_EQ(h.value(0, 0), 4);
+    BOOST_TEST_EQ(h.value(1, 0), 3);
+    BOOST_TEST_EQ(h.value(2, 0), 3);
+    BOOST_TEST_EQ(h.value(3, 0), 4);
+    BOOST_TEST_EQ(h.value(4, 0), 1);
+    auto h1 = h.rebin<0>(2);
+    BOOST_TEST(h1.axis<0>() == log_axis(2, 1, 1e4));
+    BOOST_TEST_EQ(h1.value(0, 0), 7);
+    auto h2 = h.slice<0>(1, 3);
+    BOOST_TEST_EQ(h2.axis<0>()[0], h.axis<0>()[1]);
+    BOOST_TEST_EQ(h2.value(-1, 0), 5);
+
+    std::string buf;
+    {
+      std::ostringstream os;
+      boost::archive::text_oarchive oa(os);
+      oa << h;
+      buf = os.str();
+    }
+    decltype(h) b;
+    {
+      std::istringstream is(buf);
+      boost::archive::text_iarchive ia(is);
+      ia >> b;
+    }
+    BOOST_TEST(b == h);
+    BOOST_TEST_EQ(b.axis<0>()[4], 1e4);
+  }
+
+  // log_linear_axis and quantile
+  {
+    auto h = make_static_histogram(log_linear_axis(7, 1000000));
+    for (int x = 1; x <= 10000; ++x) {
+      h.fill(x);
+    }
+    h.fill(-1);
+    BOOST_TEST_EQ(h.value(h.axis().bins()), 1);
+    BOOST_TEST_EQ(quantile(h, 0), 1);
+    BOOST_TEST_LT(std::abs(quantile(h, 0.5) / 5000 - 1), 0.01);
+    BOOST_TEST_LT(std::abs(quantile(h, 0.99) / 9900 - 1), 0.01);
+    BOOST_TEST_EQ(quantile(h, 1), h.axis()[h.axis().bins()]);
+
+    auto h2 = make_static_histogram(regular_axis<>(10, 0, 10));
+    BOOST_TEST(std::isnan(quantile(h2, 0.5)));
+    for (int i = 0; i < 10; ++i) {
+      h2.fill(i + 0.5);
+    }
+    BOOST_TEST_EQ(quantile(h2, 0.25), 2.5);
+    h2.fill(-1);
+    BOOST_TEST_EQ(quantile(h2, 0), 0);
+    BOOST_TEST_THROWS(quantile(h2, 1.5), std::out_of_range);
+  }
+
+  // lookup_axis
+  {
+    using adc_axis = lookup_axis<std::uint16_t>;
+    auto h = make_static_histogram(adc_axis({16, 64, 1024, 4096}, "adc"));
+    for (int x = 0; x < 8192; x += 8) {
+      h.fill(x);
+    }
+    BOOST_TEST_EQ(h.value(-1), 2);
+    BOOST_TEST_EQ(h.value(0), 6);
+    BOOST_TEST_EQ(h.value(1), 120);
+    BOOST_TEST_EQ(h.value(2), 384);
+    BOOST_TEST_EQ(h.value(3), 512);
+    auto h1 = h.rebin<0>(2);
+    BOOST_TEST(h1.axis() == adc_axis({16, 1024}, "adc"));
+    BOOST_TEST_EQ(h1.value(0), 126);
+    BOOST_TEST_EQ(h1.value(1), 896);
+    auto h2 = h.slice<0>(1, 2);
+    BOOST_TEST(h2.axis() == adc_axis({64, 1024}, "adc"));
+    BOOST_TEST_EQ(h2.value(-1), 8);
+
+    std::string buf;
+    {
+      std::ostringstream os;
+      boost::archive::text_oarchive oa(os);
+      oa << h;
+      buf = os.str();
+    }
+    decltype(h) b;
+    {
+      std::istringstream is(buf);
+      boost::archive::text_iarchive ia(is);
+      ia >> b;
+    }
+    BOOST_TEST(b == h);
+    BOOST_TEST_EQ(b.axis().index(100), 1);
+
+    std::ostringstream os;
+    os << h.axis();
+    BOOST_TEST_EQ(os.str(), "lookup_axis(16, 64, 1024, 4096, label='adc')");
+  }
+
+  // shift_axis
+  {
+    auto h = make_static_histogram(shift_axis(8, 0, 4, "adc"));
+    for (int x = -1; x < 130; ++x) {
+      h.fill(x);
+    }
+    BOOST_TEST_EQ(h.value(-1), 1);
+    BOOST_TEST_EQ(h.value(0), 16);
+    BOOST_TEST_EQ(h.value(7), 16);
+    BOOST_TEST_EQ(h.value(8), 2);
+    auto h1 = h.rebin<0>(4);
+    BOOST_TEST(h1.axis() == shift_axis(2, 0, 6, "adc"));
+    BOOST_TEST_EQ(h1.value(1), 64);
+    BOOST_TEST_THROWS(h.rebin<0>(3), std::logic_error);
+    auto h2 = h.slice<0>(2, 4);
+    BOOST_TEST(h2.axis() == shift_axis(2, 32, 4, "adc"));
+    BOOST_TEST_EQ(h2.value(-1), 33);
+
+    std::string buf;
+    {
+      std::ostringstream os;
+      boost::archive::text_oarchive oa(os);
+      oa << h;
+      buf = os.str();
+    }
+    decltype(h) b;
+    {
+      std::istringstream is(buf);
+      boost::archive::text_iarchive ia(is);
+      ia >> b;
+    }
+    BOOST_TEST(b == h);
+
+    std::ostringstream os;
+    os << h.axis();
+    BOOST_TEST_EQ(os.str(), "shift_axis(8, 0, 4, label='adc')");
+  }
+
+  // static_regular_axis
+  {
+    using axis_t = static_regular_axis<4, std::ratio<-2>, std::ratio<2>>;
+    auto h = make_static_histogram(axis_t("x"), integer_axis(0, 1));
+    auto r = make_static_histogram(regular_axis<>(4, -2, 2, "x"),
+                                   integer_axis(0, 1));
+    for (double x = -2.5; x < 3; x += 0.25) {
+      h.fill(x, 1);
+      r.fill(x, 1);
+    }
+    for (int i = -1; i <= 4; ++i) {
+      BOOST_TEST_EQ(h.value(i, 1), r.value(i, 1));
+    }
+    auto h1 = h.rebin<0>(2);
+    BOOST_TEST(h1.axis<0>() == regular_axis<>(2, -2, 2, "x"));
+    BOOST_TEST_EQ(h1.value(0, 1), 8);
+    auto h2 = h.slice<0>(1, 3);
+    BOOST_TEST(h2.axis<0>() == regular_axis<>(2, -1, 1, "x"));
+
+    std::string buf;
+    {
+      std::ostringstream os;
+      boost::archive::text_oarchive oa(os);
+      oa << h;
+      buf = os.str();
+    }
+    decltype(h) b;
+    BOOST_TEST_NOT(b == h);
+    {
+      std::istringstream is(buf);
+      boost::archive::text_iarchive ia(is);
+      ia >> b;
+    }
+    BOOST_TEST(b == h);
+
+    std::ostringstream os;
+    os << h.axis<0>();
+    BOOST_TEST_EQ(os.str(), "static_regular_axis(4, -2, 2, label='x')");
+  }
+
+  // fill_n
+  {
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    // 130 entries span more than one block, with values on and near edges
+    std::vector<double> x, y;
+    std::vector<float> z;
+    for (int i = 0; i < 130; ++i) {
+      x.push_back(-1.2 + 0.02 * i);
+      y.push_back(i % 7 == 0 ? nan : 0.1 * (i % 13) - 0.3);
+      z.push_back(0.05f * (i % 31) - 0.25f);
+    }
+    auto a = make_static_histogram(regular_axis<>(5, -1, 1),
+                                   regular_axis<>(3, 0, 0.9, "", false),
+                                   regular_axis<float>(4, 0, 1));
+    auto b = a;
+    a.fill_n(x.size(), x.begin(), y.begin(), z.data());
+    for (unsigned i = 0; i < x.size(); ++i) {
+      b.fill(x[i], y[i], z[i]);
+    }
+    BOOST_TEST(a == b);
+    BOOST_TEST_GT(a.sum(), 0);
+    BOOST_TEST_LT(a.sum(), x.size());
+
+    // not all axes regular
+    auto c = make_static_histogram(regular_axis<>(5, -1, 1), integer_axis(0, 3));
+    auto d = c;
+    const int k[] = {0, 1, 2, 3, 4};
+    c.fill_n(5, x.begin() + 50, k);
+    for (unsigned i = 0; i < 5; ++i) {
+      d.fill(x[50 + i], k[i]);
+    }
+    BOOST_TEST(c == d);
+
+    // fill modes
+    for (const auto mode : {fill_mode::direct, fill_mode::prefetched,
+                            fill_mode::bucketed}) {
+      auto a2 = make_static_histogram(regular_axis<>(5, -1, 1),
+                                      regular_axis<>(3, 0, 0.9, "", false),
+                                      regular_axis<float>(4, 0, 1));
+      a2.fill_n(mode, x.size(), x.begin(), y.begin(), z.data());
+      BOOST_TEST(a2 == b);
+      auto c2 = make_static_histogram(regular_axis<>(5, -1, 1),
+                                      integer_axis(0, 3, "", false));
+      auto d2 = c2;
+      c2.fill_n(mode, 5, x.begin() + 50, k);
+      for (unsigned i = 0; i < 5; ++i) {
+        d2.fill(x[50 + i], k[i]);
+      }
+      BOOST_TEST(c2 == d2);
+      BOOST_TEST_EQ(c2.sum(), 4);
+
+      // entries outside of the axes have no bin to prefetch
+      auto e2 =
+          make_static_histogram_with<container_storage<std::vector<unsigned>>>(
+              regular_axis<>(10, 0, 10, "", false),
+              regular_axis<>(10, 0, 10, "", false));
+      std::vector<double> u, v;
+      for (int i = 0; i < 64; ++i) {
+        u.push_back(i % 4 ? 5 : i % 10 + 0.5);
+        v.push_back(i % 4 ? 20 + i : 2.5);
+      }
+      e2.fill_n(mode, u.size(), u.begin(), v.begin());
+      BOOST_TEST_EQ(e2.sum(), 16);
+      BOOST_TEST_EQ(e2.value(0, 2), 4);
+      BOOST_TEST_EQ(e2.value(4, 2), 3);
+    }
+
+    // growth falls back to fill
+    auto e = make_static_histogram(regular_axis<>(2, 0, 1, "", false, true));
+    e.fill_n(x.size(), x.begin());
+    BOOST_TEST_EQ(e.sum(), x.size());
+    BOOST_TEST_EQ(e.axis<0>()[0], -1.5);
+  }
+
+  // masked_fill_n
+  {
+    std::vector<double> x, y;
+    std::vector<char> mask;
+    unsigned char bits[17] = {0};
+    for (int i = 0; i < 130; ++i) {
+      x.push_back(-1.2 + 0.02 * i);
+      y.push_back(0.1 * (i % 13) - 0.3);
+      mask.push_back(i % 3 != 0);
+      bits[i / 8] |= (i % 3 != 0) << (i % 8);
+    }
+    auto a = make_static_histogram(regular_axis<>(5, -1, 1),
+                                   regular_axis<>(3, 0, 0.9, "", false));
+    auto b = a, c = a;
+    a.masked_fill_n(x.size(), mask.begin(), x.begin(), y.begin());
+    for (unsigned i = 0; i < x.size(); ++i) {
+      if (mask[i]) {
+        b.fill(x[i], y[i]);
+      }
+    }
+    BOOST_TEST(a == b);
+    BOOST_TEST_GT(a.sum(), 0);
+    c.masked_fill_n(x.size(), bit_iterator(bits), x.begin(), y.begin());
+    BOOST_TEST(c == b);
+
+    // not all axes regular
+    auto d = make_static_histogram(integer_axis(0, 3));
+    const int k[] = {0, 1, 2, 3};
+    const bool m[] = {true, false, true, true};
+    d.masked_fill_n(4, m, k);
+    BOOST_TEST_EQ(d.value(0), 1);
+    BOOST_TEST_EQ(d.value(1), 0);
+    BOOST_TEST_EQ(d.sum(), 3);
+
+    // growth falls back to fill
+    auto e = make_static_histogram(regular_axis<>(2, 0, 1, "", false, true));
+    e.masked_fill_n(x.size(), mask.begin(), x.begin());
+    BOOST_TEST_EQ(e.sum(), std::count(mask.begin(), mask.end(), 1));
+  }
+
+  // growth
+  {
+    auto h = make_static_histogram(regular_axis<>(2, 0, 2, "", false, true),
+                                   integer_axis(0, 1, "", false, true),
+                                   integer_axis(0, 1));
+    h.add_marginal<1>();
+    h.fill(0.5, 0, 0);
+    h.wfill(2, 1.5, 1, 1);
+    h.fill(-1.5, 0, 1);
+    BOOST_TEST_EQ(h.axis<0>().bins(), 4);
+    BOOST_TEST_EQ(h.axis<0>()[0], -2);
+    BOOST_TEST_EQ(h.value(2, 0, 0), 1);
+    BOOST_TEST_EQ(h.value(3, 1, 1), 2);
+    BOOST_TEST_EQ(h.variance(3, 1, 1), 4);
+    BOOST_TEST_EQ(h.value(0, 0, 1), 1);
+    h.fill(0.5, 5, 0);
+    BOOST_TEST_EQ(h.axis<1>().bins(), 6);
+    BOOST_TEST_EQ(h.value(2, 5, 0), 1);
+    BOOST_TEST_EQ(h.value(3, 1, 1), 2);
+    BOOST_TEST_EQ(h.sum(), 5);
+    // the axis without growth still counts in the overflow bin
+    h.fill(10.0, 20, 5);
+    BOOST_TEST_EQ(h.axis<0>().bins(), 13);
+    BOOST_TEST_EQ(h.axis<1>().bins(), 21);
+    BOOST_TEST_EQ(h.value(2, 0, 0), 1);
+    BOOST_TEST_EQ(h.value(12, 20, 2), 1);
+    BOOST_TEST_EQ(h.sum(), 6);
+    const auto m = h.marginal<1>();
+    BOOST_TEST(m == h.project<1>());
+    BOOST_TEST_EQ(m.value(5), 1);
+    h.fill(std::numeric_limits<double>::quiet_NaN(), 0, 0);
+    BOOST_TEST_EQ(h.sum(), 6);
+  }
+
+  // growth of category_axis
+  {
+    auto h = make_static_histogram(regular_axis<>(2, 0, 2),
+                                   category_axis({}, "", false, true));
+    h.add_marginal<1>();
+    h.fill(0.5, "b");
+    h.fill(1.5, "a");
+    h.fill(0.5, "b");
+    h.wfill(3, -1.0, std::string("c"));
+    BOOST_TEST_EQ(h.axis<1>().bins(), 3);
+    BOOST_TEST_EQ(h.axis<1>().index("b"), 0);
+    BOOST_TEST_EQ(h.axis<1>().index("a"), 1);
+    BOOST_TEST_EQ(h.value(0, 0), 2);
+    BOOST_TEST_EQ(h.value(1, 1), 1);
+    BOOST_TEST_EQ(h.value(-1, 2), 3);
+    BOOST_TEST_EQ(h.variance(-1, 2), 9);
+    BOOST_TEST_EQ(h.sum(), 6);
+    BOOST_TEST(h.marginal<1>() == h.project<1>());
+    BOOST_TEST_EQ(h.marginal<1>().value(2), 3);
+  }
+
+  // growth of category_axis into reserved bins
+  {
+    auto h = make_static_histogram(integer_axis(0, 1),
+                                   category_axis({}, "", false, true));
+    h.add_marginal<1>();
+    for (int i = 0; i < 40; ++i) {
+      h.fill(i % 2, std::to_string(i));
+      h.fill(i % 2, std::to_string(i / 2));
+    }
+    BOOST_TEST_EQ(h.axis<1>().bins(), 40);
+    BOOST_TEST_EQ(h.axis<1>().shape(), 64);
+    // the reserved bins are storage only, size() does not count them
+    BOOST_TEST_EQ(h.size(), 4u * 40u);
+    BOOST_TEST_EQ(h.sum(), 80);
+    BOOST_TEST_EQ(h.value(0, 0), 2);
+    BOOST_TEST_EQ(h.value(1, 0), 1);
+    BOOST_TEST_EQ(h.value(1, 39), 1);
+    BOOST_TEST_EQ(h.value(0, 19), 1);
+    BOOST_TEST_EQ(h.value(1, 19), 2);
+    BOOST_TEST_EQ(h.value(0, 40), 0);
+    BOOST_TEST(h.marginal<1>() == h.project<1>());
+    const auto s = h.slice<1>(10, 20);
+    BOOST_TEST_EQ(s.axis<1>().bins(), 10);
+    BOOST_TEST_EQ(s.axis<1>().shape(), 16);
+    BOOST_TEST_EQ(s.value(0, 0), h.value(0, 10));
+    BOOST_TEST_EQ(s.sum(), 30);
+    std::vector<indexed_bin<double>> bins;
+    h.for_each_bin(
+        [&bins](const indexed_bin<double> &b) { bins.push_back(b); });
+    BOOST_TEST_EQ(bins.size(), h.size());
+    double sum = 0;
+    for (const auto &b : bins) {
+      BOOST_TEST(0 <= b.idx(1) && b.idx(1) < 40);
+      BOOST_TEST_EQ(b.value, h.value(b.idx(0), b.idx(1)));
+      sum += b.value;
+    }
+    BOOST_TEST_EQ(sum, h.sum());
+    BOOST_TEST_EQ(bins[4 * 39 + 3].idx(0), -1);
+    BOOST_TEST_EQ(bins[4 * 39 + 3].idx(1), 39);
+    std::size_t n = 0;
+    for (const auto &b : indexed(h)) {
+      BOOST_TEST_EQ(b.idx(0), bins[n].idx(0));
+      BOOST_TEST_EQ(b.idx(1), bins[n].idx(1));
+      ++n;
+    }
+    BOOST_TEST_EQ(n, h.size());
+  }
+
   // histogram_serialization
   {
     auto a = make_static_histogram(
@@ -535,6 +1346,77 @@ int main() {
     BOOST_TEST(a == b);
   }
 
+  // histogram_serialization of an archive without growth flags
+  {
+    const std::string buf =
+        "22 serialization::archive 18 0 0 0 0 0 0 2 4 1 r "
+        "0.00000000000000000e+00 1.00000000000000000e+00 0 0 2 4 1 i 0 0 0 16 "
+        "1 0 0 0 0 1 0 0 0 0 0 0 0 0 0 0 0";
+    auto a = make_static_histogram(regular_axis<>(2, 0, 2, "r"),
+                                   integer_axis(0, 1, "i"));
+    a.fill(0.5, 1);
+    auto b = make_static_histogram(regular_axis<>(1, 0, 1, "", false, true),
+                                   integer_axis(0, 0, "", false, true));
+    {
+      std::istringstream is(buf);
+      boost::archive::text_iarchive ia(is);
+      ia >> b;
+    }
+    BOOST_TEST(a == b);
+    BOOST_TEST(!b.axis<0>().growth());
+    BOOST_TEST(!b.axis<1>().growth());
+    b.fill(5.0, 1);
+    BOOST_TEST_EQ(b.axis<0>().bins(), 2);
+    BOOST_TEST_EQ(b.value(2, 1), 1);
+  }
+
+  // histogram_serialization of a category_axis without flags
+  {
+    const std::string buf = "22 serialization::archive 18 0 0 0 0 0 0 2 0  1 "
+                            "A 1 B 0 0 2 1 0 1";
+    auto b = make_static_histogram(category_axis({"X"}, "", true));
+    {
+      std::istringstream is(buf);
+      boost::archive::text_iarchive ia(is);
+      ia >> b;
+    }
+    BOOST_TEST(b.axis<0>() == category_axis({"A", "B"}));
+    BOOST_TEST_EQ(b.value(1), 1);
+  }
+
+  // histogram_serialization into a histogram with a marginal
+  {
+    auto a = make_static_histogram(regular_axis<>(3, -1, 1),
+                                   integer_axis(0, 3));
+    a.fill(0.5, 3);
+    std::string buf;
+    {
+      std::ostringstream os;
+      boost::archive::text_oarchive oa(os);
+      oa << a;
+      buf = os.str();
+    }
+    auto b = make_static_histogram(regular_axis<>(1, -1, 1),
+                                   integer_axis(0, 0));
+    b.add_marginal<1>();
+    b.fill(0.0, 0);
+    {
+      std::istringstream is(buf);
+      boost::archive::text_iarchive ia(is);
+      ia >> b;
+    }
+    BOOST_TEST(a == b);
+    BOOST_TEST_THROWS(b.marginal<1>(), std::logic_error);
+    b.fill(-0.5, 3);
+    b.fill(0.5, 0);
+    BOOST_TEST_EQ(b.value(2, 3), 1);
+    BOOST_TEST_EQ(b.value(0, 3), 1);
+    BOOST_TEST_EQ(b.sum(), 3);
+    const summed_area_table t(b);
+    BOOST_TEST_EQ(t.integral(0, 3, 3, 4), 2);
+    BOOST_TEST_EQ(t.integral(-1, -1, 4, 5), 3);
+  }
+
   // histogram_ostream
   {
     auto a = make_static_histogram(regular_axis<>(3, -1, 1, "r"),